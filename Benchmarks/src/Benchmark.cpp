@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+
+#include <chrono>
+#include <fstream>
+
+namespace Zahra
+{
+	const void* volatile g_BenchmarkSink = nullptr;
+
+	namespace BenchmarkUtils
+	{
+		static void WriteJSON(std::ofstream& stream, const std::vector<BenchmarkResult>& results)
+		{
+			stream << "{\n\t\"benchmarks\": [\n";
+
+			for (size_t i = 0; i < results.size(); i++)
+			{
+				const auto& result = results[i];
+
+				stream << "\t\t{ \"name\": \"" << result.Name << "\""
+					<< ", \"iterations\": " << result.Iterations
+					<< ", \"seconds\": " << result.Seconds
+					<< ", \"iterations_per_second\": " << result.IterationsPerSecond
+					<< ", \"ns_per_iteration\": " << result.NanosecondsPerIteration
+					<< ", \"allocations_per_iteration\": " << result.AllocationsPerIteration
+					<< ", \"bytes_per_iteration\": " << result.BytesPerIteration
+					<< " }" << (i + 1 < results.size() ? "," : "") << "\n";
+			}
+
+			stream << "\t]\n}\n";
+		}
+
+		static void WriteCSV(std::ofstream& stream, const std::vector<BenchmarkResult>& results)
+		{
+			stream << "Name,Iterations,Seconds,IterationsPerSecond,NsPerIteration,AllocationsPerIteration,BytesPerIteration\n";
+
+			for (const auto& result : results)
+			{
+				stream << result.Name << "," << result.Iterations << "," << result.Seconds << ","
+					<< result.IterationsPerSecond << "," << result.NanosecondsPerIteration << ","
+					<< result.AllocationsPerIteration << "," << result.BytesPerIteration << "\n";
+			}
+		}
+	}
+
+	BenchmarkRunner::BenchmarkRunner(const std::string& filter, double minSeconds)
+		: m_Filter(filter), m_MinSeconds(minSeconds)
+	{
+	}
+
+	bool BenchmarkRunner::ShouldRun(const std::string& name) const
+	{
+		return m_Filter.empty() || name.find(m_Filter) != std::string::npos;
+	}
+
+	void BenchmarkRunner::Run(const std::string& name, const BenchmarkFn& body)
+	{
+		if (!ShouldRun(name)) return;
+
+		// warm caches (and any lazily grown buffers) before measuring
+		body(1);
+
+		uint64_t iterations = 1;
+		while (true)
+		{
+			AllocationStats before = Memory::GetAllocationStats();
+			auto start = std::chrono::steady_clock::now();
+
+			body(iterations);
+
+			auto end = std::chrono::steady_clock::now();
+			AllocationStats after = Memory::GetAllocationStats();
+
+			double seconds = std::chrono::duration<double>(end - start).count();
+			if (seconds >= m_MinSeconds)
+			{
+				BenchmarkResult& result = m_Results.emplace_back();
+				result.Name = name;
+				result.Iterations = iterations;
+				result.Seconds = seconds;
+				result.IterationsPerSecond = iterations / seconds;
+				result.NanosecondsPerIteration = seconds * 1e9 / iterations;
+				result.AllocationsPerIteration = (double)(after.AllocationCount - before.AllocationCount) / iterations;
+				result.BytesPerIteration = (double)(after.TotalAllocated - before.TotalAllocated) / iterations;
+
+				Z_INFO("{0:<32} {1:>12.1f} ns/iter {2:>14.1f} iter/s {3:>8.2f} allocs/iter {4:>10.1f} bytes/iter", name,
+					result.NanosecondsPerIteration, result.IterationsPerSecond, result.AllocationsPerIteration, result.BytesPerIteration);
+				return;
+			}
+
+			// aim a little past the minimum, growing by at most 100x at a time in case the batch was too short to time
+			double scale = seconds > .0 ? 1.2 * m_MinSeconds / seconds : 100.0;
+			iterations = std::max(iterations + 1, (uint64_t)(iterations * std::min(scale, 100.0)));
+		}
+	}
+
+	bool BenchmarkRunner::WriteResults(const std::filesystem::path& filepath) const
+	{
+		std::ofstream stream(filepath);
+		if (!stream)
+		{
+			Z_WARN("Failed to open '{0}' for writing benchmark results", filepath.string());
+			return false;
+		}
+
+		if (filepath.extension() == ".csv")
+			BenchmarkUtils::WriteCSV(stream, m_Results);
+		else
+			BenchmarkUtils::WriteJSON(stream, m_Results);
+
+		Z_INFO("Wrote {0} benchmark results to '{1}'", m_Results.size(), filepath.string());
+		return true;
+	}
+
+}
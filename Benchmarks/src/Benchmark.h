@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Zahra.h>
+
+#include <atomic>
+#include <functional>
+
+namespace Zahra
+{
+	struct BenchmarkResult
+	{
+		std::string Name;
+		uint64_t Iterations = 0;
+		double Seconds = .0;
+		double IterationsPerSecond = .0;
+		double NanosecondsPerIteration = .0;
+		double AllocationsPerIteration = .0; // always 0 unless memory tracking is compiled in (i.e. not in Distribution)
+		double BytesPerIteration = .0;
+	};
+
+	// Runs each benchmark's body in ever larger batches until one takes at least the minimum time, and reports that
+	// batch. Allocation figures come from the engine's memory tracking, so they include any allocations made by the
+	// engine on other threads while the batch runs.
+	class BenchmarkRunner
+	{
+	public:
+		// the body should do its work the given number of times
+		using BenchmarkFn = std::function<void(uint64_t iterations)>;
+
+		// only benchmarks whose names contain the filter are run (all of them if it's empty)
+		BenchmarkRunner(const std::string& filter = "", double minSeconds = .5);
+
+		void Run(const std::string& name, const BenchmarkFn& body);
+
+		const std::vector<BenchmarkResult>& GetResults() const { return m_Results; }
+
+		// writes CSV if the extension is ".csv", and JSON otherwise
+		bool WriteResults(const std::filesystem::path& filepath) const;
+
+	private:
+		std::string m_Filter;
+		double m_MinSeconds;
+		std::vector<BenchmarkResult> m_Results;
+
+		bool ShouldRun(const std::string& name) const;
+	};
+
+	extern const void* volatile g_BenchmarkSink;
+
+	// stop the compiler discarding a result the benchmark never otherwise uses
+	template<typename T>
+	inline void DoNotOptimise(const T& value)
+	{
+		g_BenchmarkSink = &value;
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+
+	// a framebuffer with the same attachments as the editor viewport, which Renderer2D's shaders write to
+	Ref<Framebuffer> CreateOffscreenRenderTarget(uint32_t width, uint32_t height);
+
+	// each sets up its fixtures and hands its benchmarks to the runner
+	void RunCoreBenchmarks(BenchmarkRunner& runner);
+	void RunSceneBenchmarks(BenchmarkRunner& runner);
+	void RunRendererBenchmarks(BenchmarkRunner& runner);
+
+}
@@ -0,0 +1,154 @@
+#include <Zahra.h>
+#include <Zahra/Core/EntryPoint.h>
+
+#include "Benchmark.h"
+#include "ScenarioRunner.h"
+
+namespace Zahra
+{
+	struct BenchmarkOptions
+	{
+		std::string Filter;
+		std::filesystem::path OutputPath; // defaults to benchmark_results.json, or the scenario's default
+		double MinSeconds = .5;
+		bool Headless = false;
+
+		bool RunScenario = false;
+		ScenarioOptions Scenario;
+	};
+
+	// usage:
+	//	Benchmarks [--filter <substring>] [--out <results.json|results.csv>] [--min-time <seconds>] [--headless]
+	//	Benchmarks --scenario <project.zpj> [--scene <scene.zsc>] [--frames <n>] [--warmup <n>] [--out <results.yml>]
+	//		[--frame-times <frames.csv>] [--baseline <baseline.yml>] [--update-baseline] [--tolerance <fraction>]
+	//		[--min-tolerance <ms>] [--headless]
+	static BenchmarkOptions ParseOptions(const ApplicationCommandLineArgs& args)
+	{
+		BenchmarkOptions options;
+		ScenarioOptions& scenario = options.Scenario;
+
+		for (int i = 1; i < args.Count; i++)
+		{
+			std::string arg = args[i];
+			bool hasValue = i + 1 < args.Count;
+
+			if (arg == "--filter" && hasValue)
+				options.Filter = args[++i];
+			else if (arg == "--out" && hasValue)
+				options.OutputPath = args[++i];
+			else if (arg == "--min-time" && hasValue)
+				options.MinSeconds = std::stod(args[++i]);
+			else if (arg == "--headless")
+				options.Headless = true;
+			else if (arg == "--scenario" && hasValue)
+			{
+				options.RunScenario = true;
+				scenario.ProjectFilepath = args[++i];
+			}
+			else if (arg == "--scene" && hasValue)
+				scenario.SceneFilepath = args[++i];
+			else if (arg == "--frames" && hasValue)
+				scenario.Frames = (uint32_t)std::max(std::stoi(args[++i]), 1);
+			else if (arg == "--warmup" && hasValue)
+				scenario.WarmupFrames = (uint32_t)std::max(std::stoi(args[++i]), 0);
+			else if (arg == "--frame-times" && hasValue)
+				scenario.FrameTimesPath = args[++i];
+			else if (arg == "--baseline" && hasValue)
+				scenario.BaselinePath = args[++i];
+			else if (arg == "--update-baseline")
+				scenario.UpdateBaseline = true;
+			else if (arg == "--tolerance" && hasValue)
+				scenario.RelativeTolerance = std::stof(args[++i]);
+			else if (arg == "--min-tolerance" && hasValue)
+				scenario.AbsoluteTolerance = std::stof(args[++i]);
+			else
+				Z_WARN("Unrecognised benchmark argument '{0}'", arg);
+		}
+
+		if (options.RunScenario && !options.OutputPath.empty())
+			scenario.OutputPath = options.OutputPath;
+		else if (options.OutputPath.empty())
+			options.OutputPath = "benchmark_results.json";
+
+		return options;
+	}
+
+	class BenchmarkLayer : public Layer
+	{
+	public:
+		BenchmarkLayer(const BenchmarkOptions& options)
+			: Layer("Benchmark_Layer"), m_Options(options) {}
+
+		// everything runs within the first frame, once the engine is fully up
+		void OnUpdate(float dt) override
+		{
+			if (m_Finished) return;
+
+			BenchmarkRunner runner(m_Options.Filter, m_Options.MinSeconds);
+
+			RunCoreBenchmarks(runner);
+			RunSceneBenchmarks(runner);
+
+			if (!Application::Get().IsHeadless())
+				RunRendererBenchmarks(runner);
+
+			runner.WriteResults(m_Options.OutputPath);
+
+			m_Finished = true;
+			Application::Get().Exit();
+		}
+
+	private:
+		BenchmarkOptions m_Options;
+		bool m_Finished = false;
+	};
+
+	class Benchmarks : public Application
+	{
+	public:
+		Benchmarks(const ApplicationSpecification& spec, const BenchmarkOptions& options)
+			: Application(spec)
+		{
+			if (options.RunScenario)
+				PushLayer(new ScenarioLayer(options.Scenario));
+			else
+				PushLayer(new BenchmarkLayer(options));
+		}
+	};
+
+	Application* CreateApplication(ApplicationCommandLineArgs args)
+	{
+		BenchmarkOptions options = ParseOptions(args);
+
+		// run from Meadow's directory, for its shaders and mono runtime
+		ApplicationSpecification spec;
+		spec.Name = "Benchmarks";
+		spec.Version = ApplicationVersion(0, 1, 0);
+		spec.WorkingDirectory = ".";
+		spec.CommandLineArgs = args;
+
+		// projects can only be loaded with the editor's asset manager, for now
+		spec.IsEditor = options.RunScenario;
+
+		spec.ShaderSourceDirectory = "./Resources/Shaders";
+		spec.ShaderCacheDirectory = "./Cache/Shaders";
+
+		spec.RendererConfig.DesiredFramesInFlight = 3;
+		spec.RendererConfig.ForceShaderRecompilation = false;
+
+		spec.GPURequirements.MinBoundTextureSlots = 32;
+
+		spec.ImGuiConfig.Enabled = false;
+		spec.Headless.Enabled = options.Headless;
+
+		// count every allocation, rather than estimating from a sample
+		spec.MemoryTrackingSampleInterval = 1;
+
+		// keep every measured frame of a scenario
+		if (options.RunScenario)
+			spec.FrameStatsHistorySize = options.Scenario.Frames;
+
+		return new Benchmarks(spec, options);
+	}
+
+}
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Zahra
+{
+	static void BenchmarkAllocator(BenchmarkRunner& runner)
+	{
+		runner.Run("Allocator::Allocate/Free (64 bytes)", [](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					void* block = Allocator::Allocate(64, "Benchmarks");
+					DoNotOptimise(block);
+					Allocator::Free(block);
+				}
+			});
+
+		// a burst of mixed sizes, freed in reverse order, closer to what a frame's worth of containers does
+		runner.Run("Allocator::Allocate/Free (mixed x64)", [](uint64_t iterations)
+			{
+				void* blocks[64];
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					for (size_t b = 0; b < 64; b++)
+						blocks[b] = Allocator::Allocate(16 << (b % 8), "Benchmarks");
+
+					for (size_t b = 64; b > 0; b--)
+						Allocator::Free(blocks[b - 1]);
+				}
+			});
+	}
+
+	static void BenchmarkUUIDMap(BenchmarkRunner& runner)
+	{
+		const size_t entryCount = 10000;
+
+		UUIDMap<uint32_t> map;
+		std::vector<UUID> keys(entryCount);
+		for (size_t i = 0; i < entryCount; i++)
+			map[keys[i]] = (uint32_t)i;
+
+		// visit the keys in a shuffled order, so that lookups don't just walk the slot array
+		std::vector<UUID> lookups = keys;
+		std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(0));
+
+		std::vector<UUID> misses(entryCount);
+
+		runner.Run("UUIDMap::Find (hit)", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+					DoNotOptimise(map.Find(lookups[i % entryCount]));
+			});
+
+		runner.Run("UUIDMap::Find (miss)", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+					DoNotOptimise(map.Find(misses[i % entryCount]));
+			});
+	}
+
+	static void BenchmarkTransforms(BenchmarkRunner& runner)
+	{
+		std::vector<TransformComponent> transforms(1024);
+		for (size_t i = 0; i < transforms.size(); i++)
+		{
+			auto& transform = transforms[i];
+			transform.Translation = { (float)i, .5f * i, -.25f * i };
+			transform.SetRotation({ .01f * i, .02f * i, .03f * i });
+			transform.Scale = { 1.0f, 2.0f, .5f };
+		}
+
+		runner.Run("TransformComponent::GetTransform", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					glm::mat4 matrix = transforms[i % transforms.size()].GetTransform();
+					DoNotOptimise(matrix);
+				}
+			});
+	}
+
+	void RunCoreBenchmarks(BenchmarkRunner& runner)
+	{
+		BenchmarkAllocator(runner);
+		BenchmarkUUIDMap(runner);
+		BenchmarkTransforms(runner);
+	}
+
+}
@@ -0,0 +1,62 @@
+#include "Benchmark.h"
+
+namespace Zahra
+{
+	Ref<Framebuffer> CreateOffscreenRenderTarget(uint32_t width, uint32_t height)
+	{
+		FramebufferSpecification framebufferSpec{};
+		framebufferSpec.Name = "Benchmarks_Framebuffer";
+		framebufferSpec.Width = width;
+		framebufferSpec.Height = height;
+		{
+			auto& attachment = framebufferSpec.ColourAttachmentSpecs.emplace_back();
+			attachment.Format = ImageFormat::RGBA_UN;
+		}
+		{
+			auto& attachment = framebufferSpec.ColourAttachmentSpecs.emplace_back();
+			attachment.Format = ImageFormat::R32_SI;
+		}
+		framebufferSpec.HasDepthStencil = true;
+		framebufferSpec.DepthClearValue = 1.0f;
+		framebufferSpec.DepthStencilAttachmentSpec.Format = ImageFormat::DepthStencil;
+
+		return Framebuffer::Create(framebufferSpec);
+	}
+
+	// only the CPU side of the 2D renderer is measured (filling its batches with vertices), so nothing is ever drawn
+	void RunRendererBenchmarks(BenchmarkRunner& runner)
+	{
+		Renderer2DSpecification rendererSpec{};
+		rendererSpec.RenderTarget = CreateOffscreenRenderTarget(1, 1);
+		Ref<Renderer2D> renderer = Ref<Renderer2D>::Create(rendererSpec);
+
+		std::vector<glm::mat4> transforms(1024);
+		for (size_t i = 0; i < transforms.size(); i++)
+		{
+			TransformComponent transform;
+			transform.Translation = { (float)(i % 32), (float)(i / 32), .0f };
+			transform.SetRotation({ .0f, .0f, .1f * i });
+			transforms[i] = transform.GetTransform();
+		}
+
+		const glm::mat4 identity(1.0f);
+		const glm::vec4 colour(.8f, .2f, .3f, 1.0f);
+
+		// restart the scene every so often, so that the batches are reused rather than growing without bound
+		const uint64_t quadsPerScene = 10000;
+
+		runner.Run("Renderer2D::DrawQuad (flat colour)", [&](uint64_t iterations)
+			{
+				renderer->BeginScene(identity, identity);
+
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					if (i % quadsPerScene == quadsPerScene - 1)
+						renderer->BeginScene(identity, identity);
+
+					renderer->DrawQuad(transforms[i % transforms.size()], colour, (int)i);
+				}
+			});
+	}
+
+}
@@ -0,0 +1,309 @@
+#include "ScenarioRunner.h"
+
+#include "Benchmark.h"
+#include "Zahra/Scene/SceneSerialiser.h"
+#include "Zahra/Scripting/ScriptEngine.h"
+
+#ifndef YAML_CPP_STATIC_DEFINE
+#define YAML_CPP_STATIC_DEFINE
+#endif
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace Zahra
+{
+	namespace ScenarioUtils
+	{
+		static constexpr uint32_t c_ViewportWidth = 1280;
+		static constexpr uint32_t c_ViewportHeight = 720;
+
+		static bool WriteResults(const std::filesystem::path& filepath, const ScenarioOptions& options)
+		{
+			YAML::Emitter out;
+			out << YAML::BeginMap;
+			{
+				out << YAML::Key << "Scenario" << YAML::BeginMap;
+				{
+					out << YAML::Key << "Project" << YAML::Value << options.ProjectFilepath.filename().string();
+					out << YAML::Key << "Scene" << YAML::Value << options.SceneFilepath.generic_string();
+					out << YAML::Key << "Frames" << YAML::Value << FrameStats::GetSampleCount();
+					out << YAML::Key << "Headless" << YAML::Value << Application::Get().IsHeadless();
+				}
+				out << YAML::EndMap;
+
+				out << YAML::Key << "Phases" << YAML::BeginMap;
+				for (uint32_t phase = 0; phase < (uint32_t)FramePhase::Count; phase++)
+				{
+					FrameTimeSummary summary = FrameStats::GetSummary((FramePhase)phase);
+
+					out << YAML::Key << FrameStats::GetPhaseName((FramePhase)phase) << YAML::BeginMap;
+					{
+						out << YAML::Key << "Mean" << YAML::Value << summary.Mean;
+						out << YAML::Key << "P50" << YAML::Value << summary.P50;
+						out << YAML::Key << "P95" << YAML::Value << summary.P95;
+						out << YAML::Key << "P99" << YAML::Value << summary.P99;
+						out << YAML::Key << "Max" << YAML::Value << summary.Max;
+					}
+					out << YAML::EndMap;
+				}
+				out << YAML::EndMap;
+			}
+			out << YAML::EndMap;
+
+			std::ofstream fileWrite(filepath);
+			if (!fileWrite)
+			{
+				Z_ERROR("Failed to open '{0}' for writing scenario results", filepath.string());
+				return false;
+			}
+
+			fileWrite << out.c_str();
+			Z_INFO("Scenario results written to '{0}'", filepath.string());
+			return true;
+		}
+
+		// returns the number of regressions, or -1 if the baseline couldn't be read
+		static int CompareWithBaseline(const std::filesystem::path& filepath, const ScenarioOptions& options)
+		{
+			if (!std::filesystem::exists(filepath))
+			{
+				Z_ERROR("Baseline '{0}' does not exist (run with --update-baseline to create it)", filepath.string());
+				return -1;
+			}
+
+			int regressions = 0;
+
+			// a malformed value throws on conversion just as a malformed file does on parsing
+			try
+			{
+				YAML::Node data = YAML::LoadFile(filepath.string());
+
+				auto phasesNode = data["Phases"];
+				if (!phasesNode)
+				{
+					Z_ERROR("Baseline '{0}' has no phase times", filepath.string());
+					return -1;
+				}
+
+				if (auto scenarioNode = data["Scenario"])
+				{
+					if (auto headless = scenarioNode["Headless"]; headless && headless.as<bool>() != Application::Get().IsHeadless())
+						Z_WARN("Baseline was recorded {0} headless mode, so its phase times may not be comparable", headless.as<bool>() ? "in" : "out of");
+				}
+
+				for (uint32_t phase = 0; phase < (uint32_t)FramePhase::Count; phase++)
+				{
+					const char* phaseName = FrameStats::GetPhaseName((FramePhase)phase);
+
+					auto baselineNode = phasesNode[phaseName];
+					if (!baselineNode)
+						continue;
+
+					FrameTimeSummary summary = FrameStats::GetSummary((FramePhase)phase);
+
+					auto check = [&](const char* statistic, float measured)
+						{
+							auto node = baselineNode[statistic];
+							if (!node) return;
+
+							float baseline = node.as<float>();
+							float limit = baseline + std::max(baseline * options.RelativeTolerance, options.AbsoluteTolerance);
+
+							if (measured > limit)
+							{
+								Z_ERROR("REGRESSION {0} {1}: {2:.3f}ms (baseline {3:.3f}ms, limit {4:.3f}ms)", phaseName, statistic, measured, baseline, limit);
+								regressions++;
+							}
+							else
+							{
+								Z_INFO("ok {0} {1}: {2:.3f}ms (baseline {3:.3f}ms, limit {4:.3f}ms)", phaseName, statistic, measured, baseline, limit);
+							}
+						};
+
+					check("P50", summary.P50);
+					check("P95", summary.P95);
+				}
+			}
+			catch (const YAML::Exception& ex)
+			{
+				Z_ERROR("Failed to read baseline '{0}'\n	{1}", filepath.string(), ex.what());
+				return -1;
+			}
+
+			return regressions;
+		}
+	}
+
+	ScenarioLayer::ScenarioLayer(const ScenarioOptions& options)
+		: Layer("Scenario_Layer"), m_Options(options)
+	{
+	}
+
+	void ScenarioLayer::OnAttach()
+	{
+		if (!LoadScene())
+		{
+			Fail();
+			return;
+		}
+
+		if (!Application::Get().IsHeadless())
+			CreateRenderer();
+
+		m_Scene->OnViewportResize((float)ScenarioUtils::c_ViewportWidth, (float)ScenarioUtils::c_ViewportHeight);
+		m_Scene->OnRuntimeStart();
+
+		Z_INFO("Running '{0}' for {1} frames (after {2} warmup frames)", m_Options.SceneFilepath.string(), m_Options.Frames, m_Options.WarmupFrames);
+	}
+
+	void ScenarioLayer::OnDetach()
+	{
+		if (m_Scene)
+			m_Scene->OnRuntimeStop();
+
+		m_Scene.Reset();
+		m_Renderer2D.Reset();
+		m_ClearPass.Reset();
+		m_Framebuffer.Reset();
+	}
+
+	void ScenarioLayer::OnFixedUpdate(float dt)
+	{
+		if (m_Finished) return;
+
+		m_Scene->OnFixedUpdateRuntime(dt);
+	}
+
+	void ScenarioLayer::OnUpdate(float dt)
+	{
+		if (m_Finished) return;
+
+		// the frame in which the stats are reset goes unrecorded, so this measures exactly the requested frames
+		if (m_FrameIndex == m_Options.WarmupFrames)
+			FrameStats::Reset();
+
+		if (m_FrameIndex > m_Options.WarmupFrames && FrameStats::GetSampleCount() >= m_Options.Frames)
+		{
+			Finish();
+			return;
+		}
+
+		if (m_Renderer2D)
+			Render();
+
+		m_FrameIndex++;
+	}
+
+	bool ScenarioLayer::LoadScene()
+	{
+		if (!Project::Load(m_Options.ProjectFilepath))
+		{
+			Z_ERROR("Failed to load project '{0}'", m_Options.ProjectFilepath.string());
+			return false;
+		}
+
+		std::filesystem::path assemblyFilepath = Project::GetScriptAssemblyFilepath();
+		if (!assemblyFilepath.empty() && !ScriptEngine::InitApp(assemblyFilepath))
+			Z_WARN("Failed to load script assembly '{0}', so scripted entities will do nothing", assemblyFilepath.string());
+
+		if (m_Options.SceneFilepath.empty())
+			m_Options.SceneFilepath = Project::GetStartingSceneFilepath();
+
+		if (m_Options.SceneFilepath.empty())
+		{
+			Z_ERROR("No scene given, and project '{0}' has no starting scene", Project::GetProjectName());
+			return false;
+		}
+
+		std::filesystem::path sceneFilepath = Project::GetProjectDirectory() / m_Options.SceneFilepath;
+
+		Ref<Scene> scene = Ref<Scene>::Create(sceneFilepath.filename().string());
+		if (!SceneSerialiser(scene).DeserialiseYaml(sceneFilepath.string()))
+		{
+			Z_ERROR("Failed to load scene '{0}'", sceneFilepath.string());
+			return false;
+		}
+
+		// play a copy, as the editor does
+		m_Scene = Scene::CopyScene(scene);
+		return true;
+	}
+
+	void ScenarioLayer::CreateRenderer()
+	{
+		m_Framebuffer = CreateOffscreenRenderTarget(ScenarioUtils::c_ViewportWidth, ScenarioUtils::c_ViewportHeight);
+
+		RenderPassSpecification clearPassSpec{};
+		clearPassSpec.Name = "Scenario_ClearPass";
+		clearPassSpec.RenderTarget = m_Framebuffer;
+		clearPassSpec.ClearColourAttachments = true;
+		clearPassSpec.ClearDepthAttachment = true;
+		clearPassSpec.ManagesResources = false;
+		m_ClearPass = RenderPass::Create(clearPassSpec);
+
+		Renderer2DSpecification rendererSpec{};
+		rendererSpec.RenderTarget = m_Framebuffer;
+		m_Renderer2D = Ref<Renderer2D>::Create(rendererSpec);
+	}
+
+	void ScenarioLayer::Render()
+	{
+		Renderer::BeginRenderPass(m_ClearPass, false, true);
+		Renderer::EndRenderPass();
+
+		m_Scene->SetSimulationInterpolation(Application::Get().GetFixedStepInterpolation());
+		m_Scene->OnRenderRuntime(m_Renderer2D, Entity(), glm::vec4(.0f));
+	}
+
+	void ScenarioLayer::Finish()
+	{
+		m_Finished = true;
+
+		FrameTimeSummary total = FrameStats::GetSummary(FramePhase::Total);
+		Z_INFO("Frame times over {0} frames: mean {1:.3f}ms, p50 {2:.3f}ms, p95 {3:.3f}ms, p99 {4:.3f}ms, max {5:.3f}ms",
+			total.SampleCount, total.Mean, total.P50, total.P95, total.P99, total.Max);
+
+		if (!m_Options.FrameTimesPath.empty())
+			FrameStats::ExportCSV(m_Options.FrameTimesPath);
+
+		bool success = ScenarioUtils::WriteResults(m_Options.OutputPath, m_Options);
+
+		if (!m_Options.BaselinePath.empty())
+		{
+			if (m_Options.UpdateBaseline)
+			{
+				success &= ScenarioUtils::WriteResults(m_Options.BaselinePath, m_Options);
+			}
+			else
+			{
+				int regressions = ScenarioUtils::CompareWithBaseline(m_Options.BaselinePath, m_Options);
+				if (regressions != 0)
+				{
+					if (regressions > 0)
+						Z_ERROR("{0} frame time regression(s) against '{1}'", regressions, m_Options.BaselinePath.string());
+
+					success = false;
+				}
+			}
+		}
+
+		if (!success)
+		{
+			Fail();
+			return;
+		}
+
+		Application::Get().Exit();
+	}
+
+	void ScenarioLayer::Fail()
+	{
+		m_Finished = true;
+
+		Application::Get().SetExitCode(EXIT_FAILURE);
+		Application::Get().Exit();
+	}
+
+}
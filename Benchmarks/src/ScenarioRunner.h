@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Zahra.h>
+
+namespace Zahra
+{
+	struct ScenarioOptions
+	{
+		std::filesystem::path ProjectFilepath;
+		std::filesystem::path SceneFilepath; // relative to the project directory, defaulting to its starting scene
+
+		uint32_t WarmupFrames = 60; // run, but left out of the results
+		uint32_t Frames = 600;
+
+		std::filesystem::path OutputPath = "scenario_results.yml";
+		std::filesystem::path FrameTimesPath; // if set, every measured frame's phase times are also written here as CSV
+
+		std::filesystem::path BaselinePath;
+		bool UpdateBaseline = false; // overwrite the baseline with these results, rather than checking against it
+
+		// a phase regresses when its p50 or p95 exceeds the baseline's by more than both of these
+		float RelativeTolerance = .10f;
+		float AbsoluteTolerance = .05f; // milliseconds, so that near-empty phases don't fail on timer noise
+	};
+
+	// Plays a scene from a project for a fixed number of frames, records each frame's phase times (see FrameStats) and
+	// compares their percentiles against a stored baseline, failing the app's exit code on a regression.
+	//
+	// Headless runs need no window or GPU, take no input and step the simulation exactly once per frame, so repeated
+	// runs do the same work. Otherwise, each frame is also rendered offscreen, so that the EndFrame and Present phases
+	// include the wait on the GPU.
+	class ScenarioLayer : public Layer
+	{
+	public:
+		ScenarioLayer(const ScenarioOptions& options);
+
+		void OnAttach() override;
+		void OnDetach() override;
+		void OnFixedUpdate(float dt) override;
+		void OnUpdate(float dt) override;
+
+	private:
+		ScenarioOptions m_Options;
+		Ref<Scene> m_Scene;
+
+		Ref<Framebuffer> m_Framebuffer;
+		Ref<RenderPass> m_ClearPass;
+		Ref<Renderer2D> m_Renderer2D;
+
+		uint32_t m_FrameIndex = 0;
+		bool m_Finished = false;
+
+		bool LoadScene();
+		void CreateRenderer();
+		void Render();
+
+		// write the results, check them against the baseline, and exit
+		void Finish();
+		void Fail();
+	};
+
+}
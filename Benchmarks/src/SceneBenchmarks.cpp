@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+
+#include "Zahra/Scene/SceneSerialiser.h"
+
+namespace Zahra
+{
+	// a grid of sprites, like a typical 2D level
+	static Ref<Scene> CreateSpriteScene(uint32_t width, uint32_t height)
+	{
+		Ref<Scene> scene = Ref<Scene>::Create("Benchmark_Scene");
+
+		for (uint32_t i = 0; i < width; i++)
+		{
+			for (uint32_t j = 0; j < height; j++)
+			{
+				Entity entity = scene->CreateEntity(std::to_string(i) + "," + std::to_string(j));
+
+				auto& transform = entity.GetComponents<TransformComponent>();
+				transform.Translation = { (float)i, (float)j, .0f };
+				transform.SetRotation({ .0f, .0f, .1f * (i + j) });
+
+				auto& sprite = entity.AddComponent<SpriteComponent>();
+				sprite.Tint = { (float)i / width, (float)j / height, .5f, 1.0f };
+			}
+		}
+
+		return scene;
+	}
+
+	void RunSceneBenchmarks(BenchmarkRunner& runner)
+	{
+		Ref<Scene> scene = CreateSpriteScene(32, 32);
+
+		runner.Run("Scene::CopyScene (1024 sprites)", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					Ref<Scene> copy = Scene::CopyScene(scene);
+					DoNotOptimise(copy);
+				}
+			});
+
+		std::filesystem::path filepath = std::filesystem::temp_directory_path() / "Zahra_Benchmark.zsc";
+
+		runner.Run("SceneSerialiser YAML round trip (1024 sprites)", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					SceneSerialiser(scene).SerialiseYaml(filepath.string());
+
+					Ref<Scene> loaded = Ref<Scene>::Create();
+					if (!SceneSerialiser(loaded).DeserialiseYaml(filepath.string()))
+						Z_WARN("Benchmark scene failed to deserialise");
+
+					DoNotOptimise(loaded);
+				}
+			});
+
+		std::filesystem::remove(filepath);
+
+		std::vector<UUID> entityIDs;
+		scene->ForEachEntity([&](Entity entity) { entityIDs.push_back(entity.GetID()); });
+
+		runner.Run("Scene::GetEntity (by UUID)", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; i++)
+				{
+					Entity entity = scene->GetEntity(entityIDs[(i * 7919) % entityIDs.size()]);
+					DoNotOptimise(entity);
+				}
+			});
+	}
+
+}
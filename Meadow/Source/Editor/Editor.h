@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Editor/EditorEnums.h"
+#include "Zahra/Core/PoolAllocator.h"
 #include "Zahra/Renderer/Cameras/EditorCamera.h"
 #include "Zahra/Scene/Entity.h"
 #include "Zahra/Scene/Scene.h"
@@ -17,6 +18,9 @@ namespace Zahra
 	class Edit : public RefCounted
 	{
 	public:
+		// edits are small and created constantly while working, so every subclass draws from the pool
+		Z_POOL_ALLOCATED()
+
 		virtual void Do() = 0;
 		virtual void Undo() = 0;
 
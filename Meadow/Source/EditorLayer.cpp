@@ -157,12 +157,6 @@ namespace Zahra
 
 	void EditorLayer::OnUpdate(float dt)
 	{
-		if (m_FramerateRefreshTimer.Elapsed() >= c_FramerateRefreshInterval)
-		{
-			m_FramerateRefreshTimer.Reset();
-			m_Framerate = 1.0f / dt;
-		}
-
 		if (m_AutosaveTimer.Elapsed() >= Editor::GetConfig().AutosaveInterval)
 		{
 			m_AutosaveTimer.Reset();
@@ -216,27 +210,14 @@ namespace Zahra
 				}
 				case SceneState::Play:
 				{
-					if (!m_Paused || m_StepCountdown > 0)
-					{
-						m_ActiveScene->OnUpdateRuntime(dt);
-
-						if (m_StepCountdown > 0)
-							m_StepCountdown--;
-					}
-
+					// while paused, show the latest simulation step as-is
+					m_ActiveScene->SetSimulationInterpolation(m_Paused ? 1.0f : Application::Get().GetFixedStepInterpolation());
 					m_ActiveScene->OnRenderRuntime(m_Renderer2D, Editor::GetSelectedEntity(), m_HighlightSelectionColour);
 					break;
 				}
 				case SceneState::Simulate:
 				{
-					if (!m_Paused || m_StepCountdown > 0)
-					{
-						m_ActiveScene->OnUpdateSimulation(dt);
-
-						if (m_StepCountdown > 0)
-							m_StepCountdown--;
-					}
-					
+					m_ActiveScene->SetSimulationInterpolation(m_Paused ? 1.0f : Application::Get().GetFixedStepInterpolation());
 					m_ActiveScene->OnRenderEditor(m_Renderer2D, m_EditorCamera, Editor::GetSelectedEntity(), m_HighlightSelectionColour);
 					break;
 				}
@@ -255,6 +236,32 @@ namespace Zahra
 		}
 	}
 
+	void EditorLayer::OnFixedUpdate(float dt)
+	{
+		// simulation runs at Application's fixed rate, so each step of a paused scene advances it by exactly one timestep
+		if (m_Paused && m_StepCountdown <= 0)
+			return;
+
+		switch (Editor::GetSceneState())
+		{
+			case SceneState::Play:
+			{
+				m_ActiveScene->OnFixedUpdateRuntime(dt);
+				break;
+			}
+			case SceneState::Simulate:
+			{
+				m_ActiveScene->OnFixedUpdateSimulation(dt);
+				break;
+			}
+			default:
+				return;
+		}
+
+		if (m_StepCountdown > 0)
+			m_StepCountdown--;
+	}
+
 	void EditorLayer::OnImGuiRender()
 	{
 		UIMenuBar();
@@ -269,6 +276,9 @@ namespace Zahra
 		m_SceneHierarchyPanel.OnImGuiRender();
 		m_ContentBrowserPanel.OnImGuiRender();
 
+		if (m_ShowProfilerPanel)
+			m_ProfilerPanel.OnImGuiRender(&m_ShowProfilerPanel);
+
 		UINewProjectWindow();
 		UISaveChangesPrompt();
 	}
@@ -392,6 +402,8 @@ namespace Zahra
 					window.SetFullscreen(!window.IsFullscreen());
 				}
 
+				ImGui::MenuItem("Profiler", "", &m_ShowProfilerPanel);
+
 				ImGui::EndMenu();
 			}
 
@@ -771,14 +783,67 @@ namespace Zahra
 	void EditorLayer::UIStatsWindow()
 	{
 		auto& renderer2DStats = m_Renderer2D->GetStats();
-		auto& allocationStats = Zahra::Memory::GetAllocationStats();
-		auto& allocationStatsMap = Zahra::Allocator::GetAllocationStatsMap();
+		auto allocationStats = Zahra::Memory::GetAllocationStats();
+		auto allocationStatsMap = Zahra::Allocator::GetAllocationStatsMap();
 
 		if (ImGui::Begin("Stats", NULL, ImGuiWindowFlags_NoCollapse))
 		{
 			ImGui::SeparatorText("Timing");
 			{
-				ImGui::Text("Framerate: %.2f fps", m_Framerate);
+				auto frameTimes = FrameStats::GetSummary(FramePhase::Total);
+				ImGui::Text("Framerate: %.2f fps (median)", frameTimes.P50 > .0f ? 1000.0f / frameTimes.P50 : .0f);
+
+				if (ImGui::BeginTable("##FrameTimeStats", 5, ImGuiTableColumnFlags_NoResize | ImGuiTableFlags_RowBg))
+				{
+					ImGui::TableSetupColumn("Phase (ms)");
+					ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthFixed, 50);
+					ImGui::TableSetupColumn("p95", ImGuiTableColumnFlags_WidthFixed, 50);
+					ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthFixed, 50);
+					ImGui::TableSetupColumn("max", ImGuiTableColumnFlags_WidthFixed, 50);
+					ImGui::TableHeadersRow();
+
+					for (uint32_t i = 0; i < (uint32_t)FramePhase::Count; i++)
+					{
+						auto summary = FrameStats::GetSummary((FramePhase)i);
+
+						ImGui::TableNextRow();
+						ImGui::TableSetColumnIndex(0);
+						ImGui::Text("%s", FrameStats::GetPhaseName((FramePhase)i));
+						ImGui::TableSetColumnIndex(1);
+						ImGui::Text("%.2f", summary.P50);
+						ImGui::TableSetColumnIndex(2);
+						ImGui::Text("%.2f", summary.P95);
+						ImGui::TableSetColumnIndex(3);
+						ImGui::Text("%.2f", summary.P99);
+						ImGui::TableSetColumnIndex(4);
+						ImGui::Text("%.2f", summary.Max);
+					}
+
+					ImGui::EndTable();
+				}
+
+				auto histogram = FrameStats::GetHistogram(FramePhase::Total, 50, 50.0f);
+				std::vector<float> binCounts(histogram.Counts.begin(), histogram.Counts.end());
+				ImGui::PlotHistogram("##FrameTimeHistogram", binCounts.data(), (int)binCounts.size(), 0, "frame time (0-50 ms)", .0f, FLT_MAX, ImVec2(0, 60));
+
+				if (ImGui::Button("Export frame times"))
+					FrameStats::ExportCSV("frame_stats.csv");
+
+				ImGui::SameLine();
+				if (Metrics::IsExporting())
+				{
+					if (ImGui::Button("Stop streaming metrics"))
+						Metrics::EndExport();
+				}
+				else if (ImGui::Button("Stream metrics"))
+				{
+					Metrics::BeginExport("metrics.csv");
+				}
+
+
+				auto jobStats = JobSystem::GetStats();
+				ImGui::Text("Jobs: %llu run on %u workers (%llu stolen)",
+					(unsigned long long)jobStats.JobsExecuted, jobStats.WorkerCount, (unsigned long long)jobStats.JobsStolen);
 			}
 
 			ImGui::SeparatorText("Renderer 2D");
@@ -848,6 +913,58 @@ namespace Zahra
 
 					ImGui::EndTable();
 				}
+
+				auto frameAllocatorStats = FrameAllocator::GetStats();
+				ImGui::Text("Frame arena: %.1f KB (peak %.1f KB of %.1f KB)",
+					frameAllocatorStats.CurrentUsage / 1024.0f,
+					frameAllocatorStats.HighWaterMark / 1024.0f,
+					frameAllocatorStats.Capacity / 1024.0f);
+				if (frameAllocatorStats.OverflowCount)
+					ImGui::Text("Frame arena overflows: %u", frameAllocatorStats.OverflowCount);
+
+#if Z_TRACK_MEMORY
+				if (HeapProfiler::IsActive())
+				{
+					if (ImGui::Button("Stop heap profile"))
+						HeapProfiler::EndSession();
+				}
+				else if (ImGui::Button("Start heap profile"))
+				{
+					HeapProfiler::BeginSession();
+				}
+#endif
+
+				auto memoryBudgets = MemoryBudget::GetStatus();
+				if (!memoryBudgets.empty() && ImGui::BeginTable("##MemoryBudgets", 2, ImGuiTableColumnFlags_NoResize | ImGuiTableFlags_RowBg))
+				{
+					ImGui::TableSetupColumn("Budget");
+					ImGui::TableSetupColumn("Usage", ImGuiTableColumnFlags_WidthFixed, 100);
+					ImGui::TableHeadersRow();
+
+					for (auto& budget : memoryBudgets)
+					{
+						if (budget.OverBudget)
+							ImGui::PushStyleColor(ImGuiCol_Text, { 0.9f, 0.2f, 0.2f, 1.0f });
+
+						ImGui::TableNextRow();
+						ImGui::TableSetColumnIndex(0);
+						{
+							ImGui::Text("%s", budget.Name.c_str());
+
+							if (ImGui::IsItemHovered())
+								ImGui::SetTooltip("Peak: %.1f KB\nExceeded: %u times", budget.PeakUsage / 1024.0f, budget.ExceededCount);
+						}
+						ImGui::TableSetColumnIndex(1);
+						{
+							ImGui::Text(" %.0f%%", 100.0f * (float)budget.CurrentUsage / (float)std::max<size_t>(budget.Limit, 1));
+						}
+
+						if (budget.OverBudget)
+							ImGui::PopStyleColor();
+					}
+
+					ImGui::EndTable();
+				}
 			}
 
 			ImGui::End();
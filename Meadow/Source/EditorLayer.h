@@ -19,6 +19,7 @@ namespace Zahra
 		void OnDetach() override;
 
 		void OnUpdate(float dt) override;
+		void OnFixedUpdate(float dt) override;
 		void OnImGuiRender() override;
 
 		void OnEvent(Event& event) override;
@@ -92,10 +93,6 @@ namespace Zahra
 		void SaveEditorConfigFile();
 		void LoadConfigFile();
 
-		const float c_FramerateRefreshInterval = .5f;
-		Timer m_FramerateRefreshTimer;
-		float m_Framerate = .0f;
-
 		// Viewport
 		Ref<Image2D> m_ColourPickingAttachment;
 		Ref<Framebuffer> m_ViewportFramebuffer;
@@ -112,6 +109,8 @@ namespace Zahra
 		// Editor panels
 		SceneHierarchyPanel m_SceneHierarchyPanel;
 		ContentBrowserPanel m_ContentBrowserPanel;
+		ProfilerPanel m_ProfilerPanel;
+		bool m_ShowProfilerPanel = false;
 		// TODO: make a general "Panel" class deriving from RefCounted, and replace these with Refs
 	};
 }
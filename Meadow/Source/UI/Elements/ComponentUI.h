@@ -524,7 +524,7 @@ namespace Zahra
 			ImGui::PopID();
 		}
 
-		void DrawScriptFieldTable(Entity entity, Buffer& storage)
+		void DrawScriptFieldTable(Entity entity, SharedBuffer& storage)
 		{
 			Z_CORE_ASSERT(entity.HasComponents<ScriptComponent>());
 
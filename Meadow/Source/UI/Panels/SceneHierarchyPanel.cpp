@@ -318,7 +318,7 @@ namespace Zahra
 				
 				// at this stage, currentIndex should be zero if and only if component.ScriptName is invalid
 				if (currentIndex)
-					ComponentUI::DrawScriptFieldTable(entity, scene->GetScriptFieldStorage(entity));
+					ComponentUI::DrawScriptFieldTable(entity, scene->GetMutableScriptFieldStorage(entity));
 								
 
 			}, false, true, false);
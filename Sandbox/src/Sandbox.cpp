@@ -16,8 +16,6 @@ SandboxLayer::SandboxLayer()
 
 void SandboxLayer::OnAttach()
 {
-	m_FramerateRefreshTimer.Reset();
-
 	{
 		Zahra::Image2DSpecification imageSpec{};
 		imageSpec.Name = "Sandbox_ViewportImage";
@@ -114,12 +112,6 @@ void SandboxLayer::OnUpdate(float dt)
 
 	m_Camera.OnUpdate(dt);
 
-	if (m_FramerateRefreshTimer.Elapsed() >= c_FramerateRefreshInterval)
-	{
-		m_FramerateRefreshTimer.Reset();
-		m_Framerate = 1.0f / dt;
-	}
-
 	uint32_t n = (uint32_t)m_EntityGrid.size();
 	for (uint32_t i = 0; i < n; i++)
 	{
@@ -159,15 +151,17 @@ void SandboxLayer::OnImGuiRender()
 		ImGui::End();
 	}
 
-	auto& allocationStats = Zahra::Memory::GetAllocationStats();
-	auto& allocationStatsMap = Zahra::Allocator::GetAllocationStatsMap();
+	auto allocationStats = Zahra::Memory::GetAllocationStats();
+	auto allocationStatsMap = Zahra::Allocator::GetAllocationStatsMap();
 	auto& renderer2DStats = m_Renderer2D->GetStats();
 
 	if (ImGui::Begin("Engine Statistics", 0, ImGuiWindowFlags_NoCollapse))
 	{
 		ImGui::SeparatorText("Timing");
 		{
-			ImGui::Text("Framerate: %.2f fps", m_Framerate);
+			auto frameTimes = Zahra::FrameStats::GetSummary(Zahra::FramePhase::Total);
+			ImGui::Text("Framerate: %.2f fps", frameTimes.P50 > .0f ? 1000.0f / frameTimes.P50 : .0f);
+			ImGui::Text("Frame time: %.2f ms (p99 %.2f ms, max %.2f ms)", frameTimes.P50, frameTimes.P99, frameTimes.Max);
 		}
 
 		ImGui::SeparatorText("2D Batch Renderer");
@@ -241,6 +235,8 @@ void SandboxLayer::OnImGuiRender()
 
 		ImGui::End();
 	}
+
+	m_ProfilerPanel.OnImGuiRender();
 }
 
 void SandboxLayer::OnViewportResize()
@@ -40,9 +40,7 @@ private:
 
 	std::vector<std::vector<Zahra::Entity>> m_EntityGrid;
 
-	const float c_FramerateRefreshInterval = .5f;
-	Zahra::Timer m_FramerateRefreshTimer;
-	float m_Framerate = .0f;
+	Zahra::ProfilerPanel m_ProfilerPanel;
 
 };
 
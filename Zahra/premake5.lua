@@ -82,7 +82,8 @@ project "Zahra"
 			"%{Library.WinSock}",
 			"%{Library.WinMultimedia}",
 			"%{Library.WinVersion}",
-			"%{Library.WinBCrypt}"
+			"%{Library.WinBCrypt}",
+			"%{Library.WinDbgHelp}"
 		}
 	
 	filter "configurations:Debug"
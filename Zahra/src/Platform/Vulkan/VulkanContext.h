@@ -29,6 +29,9 @@ namespace Zahra
 		static Ref<VulkanDevice> GetCurrentDevice() { return Get()->GetDevice(); }
 		static VkDevice& GetCurrentVkDevice() { return Get()->GetVkDevice(); }
 
+		// defer destruction of GPU resources until no frame in flight can still be using them
+		static void SubmitResourceFree(std::function<void()>&& freeFunction) { Get()->m_Swapchain->SubmitResourceFree(std::move(freeFunction)); }
+
 	private:
 		VkInstance m_VulkanInstance = VK_NULL_HANDLE;
 
@@ -75,7 +75,7 @@ namespace Zahra
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
-		vkDeviceWaitIdle(VulkanContext::GetCurrentVkDevice());
+		// no need to wait for the device here, as the old attachment images defer their own destruction
 
 		for (uint32_t i = 0; i < m_ColourAttachmentCount; i++)
 		{
@@ -0,0 +1,214 @@
+#include "zpch.h"
+#include "VulkanGPUProfiler.h"
+
+#include "Platform/Vulkan/VulkanUtils.h"
+#include "Zahra/Debug/Profiling.h"
+
+namespace Zahra
+{
+	namespace VulkanGPUProfilerUtils
+	{
+		static VkQueryPool CreateTimestampPool(VkDevice device, uint32_t queryCount)
+		{
+			VkQueryPoolCreateInfo queryPoolInfo{};
+			queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+			queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+			queryPoolInfo.queryCount = queryCount;
+
+			VkQueryPool queryPool;
+			VulkanUtils::ValidateVkResult(vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPool),
+				"Vulkan timestamp query pool creation failed");
+
+			return queryPool;
+		}
+	}
+
+	void VulkanGPUProfiler::Init(Ref<VulkanDevice> device, uint32_t framesInFlight)
+	{
+		m_Device = device;
+
+		const VkPhysicalDeviceLimits& limits = m_Device->GetDeviceProperties().limits;
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(m_Device->GetPhysicalDevice(), &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(m_Device->GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+		uint32_t validBits = queueFamilies[m_Device->GetQueueFamilyIndices().GraphicsIndex.value()].timestampValidBits;
+
+		m_Supported = validBits > 0 && limits.timestampPeriod > .0f;
+		if (!m_Supported)
+		{
+			Z_CORE_WARN("GPU does not support timestamp queries on the graphics queue, so GPU profiling is disabled");
+			return;
+		}
+
+		m_TimestampPeriod = limits.timestampPeriod;
+		m_TimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+		VkDevice& vkDevice = m_Device->GetVkDevice();
+
+		m_Frames.resize(framesInFlight);
+		for (auto& frame : m_Frames)
+		{
+			frame.QueryPool = VulkanGPUProfilerUtils::CreateTimestampPool(vkDevice, c_MaxQueriesPerFrame);
+			frame.Scopes.reserve(c_MaxQueriesPerFrame / 2);
+		}
+
+		m_CalibrationPool = VulkanGPUProfilerUtils::CreateTimestampPool(vkDevice, 1);
+		m_Results.resize(2 * c_MaxQueriesPerFrame);
+	}
+
+	void VulkanGPUProfiler::Shutdown()
+	{
+		if (!m_Supported) return;
+
+		VkDevice& vkDevice = m_Device->GetVkDevice();
+
+		for (auto& frame : m_Frames)
+			vkDestroyQueryPool(vkDevice, frame.QueryPool, nullptr);
+
+		vkDestroyQueryPool(vkDevice, m_CalibrationPool, nullptr);
+
+		m_Frames.clear();
+		m_InternedNames.clear();
+		m_Device.Reset();
+		m_Supported = false;
+	}
+
+	void VulkanGPUProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+	{
+		if (!m_Supported) return;
+
+		Z_PROFILE_FUNCTION();
+
+		Z_CORE_ASSERT(m_OpenScopes.empty(), "GPU profiling scope left open at the end of a frame");
+		m_OpenScopes.clear();
+
+		m_CurrentFrameIndex = frameIndex;
+		FrameQueries& frame = m_Frames[frameIndex];
+
+		// the swapchain has waited on this slot's fence, so its queries are complete
+		CollectResults(frame);
+
+		// frames from before the next slot's have all been collected, and none of its GPU work can have started
+		// before the CPU began recording it
+		frame.CPUBeginTime = Instrumentor::GetTimestamp();
+		int64_t nextBeginTime = m_Frames[(frameIndex + 1) % m_Frames.size()].CPUBeginTime;
+		Instrumentor::MarkGPUCollected(nextBeginTime);
+
+		bool recording = Instrumentor::IsActive() || Instrumentor::IsLiveCaptureEnabled();
+
+		// calibrate each time recording starts, so that clock drift is only ever accumulated over one session
+		if (recording && !m_Recording)
+			Calibrate();
+
+		m_Recording = recording;
+
+		if (m_Recording)
+			vkCmdResetQueryPool(commandBuffer, frame.QueryPool, 0, c_MaxQueriesPerFrame);
+	}
+
+	void VulkanGPUProfiler::BeginScope(VkCommandBuffer commandBuffer, const char* name)
+	{
+		if (!m_Recording) return;
+
+		FrameQueries& frame = m_Frames[m_CurrentFrameIndex];
+
+		if (frame.QueryCount + 2 > c_MaxQueriesPerFrame)
+		{
+			if (m_DroppedScopes++ == 0)
+				Z_CORE_WARN("More than {0} GPU profiling scopes in one frame, so some are being dropped", c_MaxQueriesPerFrame / 2);
+
+			m_OpenScopes.push_back(UINT32_MAX);
+			return;
+		}
+
+		GPUScope& scope = frame.Scopes.emplace_back();
+		scope.Name = name;
+		scope.BeginQuery = frame.QueryCount++;
+		scope.EndQuery = frame.QueryCount++;
+		scope.Depth = (uint32_t)m_OpenScopes.size();
+
+		m_OpenScopes.push_back((uint32_t)frame.Scopes.size() - 1);
+
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.QueryPool, scope.BeginQuery);
+	}
+
+	void VulkanGPUProfiler::EndScope(VkCommandBuffer commandBuffer)
+	{
+		if (!m_Recording) return;
+
+		Z_CORE_ASSERT(!m_OpenScopes.empty(), "No GPU profiling scope to end");
+
+		uint32_t scopeIndex = m_OpenScopes.back();
+		m_OpenScopes.pop_back();
+
+		if (scopeIndex == UINT32_MAX) return;
+
+		FrameQueries& frame = m_Frames[m_CurrentFrameIndex];
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.QueryPool, frame.Scopes[scopeIndex].EndQuery);
+	}
+
+	const char* VulkanGPUProfiler::InternName(const std::string& name)
+	{
+		return m_InternedNames.insert(name).first->c_str();
+	}
+
+	void VulkanGPUProfiler::Calibrate()
+	{
+		// let in-flight frames finish, so that the timestamp is taken as soon as the queue picks up the submission
+		vkQueueWaitIdle(m_Device->GetGraphicsQueue());
+
+		VkCommandBuffer commandBuffer = m_Device->GetTemporaryCommandBuffer();
+		vkCmdResetQueryPool(commandBuffer, m_CalibrationPool, 0, 1);
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_CalibrationPool, 0);
+
+		int64_t submitTime = Instrumentor::GetTimestamp();
+		m_Device->SubmitTemporaryCommandBuffer(commandBuffer); // waits for completion
+		int64_t completeTime = Instrumentor::GetTimestamp();
+
+		uint64_t ticks = 0;
+		VulkanUtils::ValidateVkResult(vkGetQueryPoolResults(m_Device->GetVkDevice(), m_CalibrationPool, 0, 1, sizeof(uint64_t), &ticks, sizeof(uint64_t),
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT), "Vulkan timestamp calibration failed");
+
+		m_CalibrationTicks = ticks & m_TimestampMask;
+		m_CalibrationTime = submitTime + (completeTime - submitTime) / 2;
+	}
+
+	void VulkanGPUProfiler::CollectResults(FrameQueries& frame)
+	{
+		if (frame.QueryCount > 0)
+		{
+			// pairs of (value, availability)
+			VkResult result = vkGetQueryPoolResults(m_Device->GetVkDevice(), frame.QueryPool, 0, frame.QueryCount,
+				frame.QueryCount * 2 * sizeof(uint64_t), m_Results.data(), 2 * sizeof(uint64_t),
+				VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+			if (result == VK_SUCCESS || result == VK_NOT_READY)
+			{
+				for (const auto& scope : frame.Scopes)
+				{
+					const uint64_t* begin = &m_Results[2 * scope.BeginQuery];
+					const uint64_t* end = &m_Results[2 * scope.EndQuery];
+
+					if (!begin[1] || !end[1])
+						continue;
+
+					Instrumentor::WriteGPUProfile({ scope.Name, ToCPUTime(begin[0]), ToCPUTime(end[0]), scope.Depth });
+				}
+			}
+		}
+
+		frame.QueryCount = 0;
+		frame.Scopes.clear();
+	}
+
+	int64_t VulkanGPUProfiler::ToCPUTime(uint64_t ticks) const
+	{
+		// masked, so that a counter with fewer than 64 valid bits may wrap
+		uint64_t elapsed = (ticks - m_CalibrationTicks) & m_TimestampMask;
+		return m_CalibrationTime + (int64_t)((double)elapsed * m_TimestampPeriod);
+	}
+
+}
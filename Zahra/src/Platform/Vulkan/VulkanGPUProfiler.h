@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Platform/Vulkan/VulkanDevice.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace Zahra
+{
+	// Brackets GPU work with timestamp queries, and hands the results to the Instrumentor as a "GPU" lane, converted
+	// to CPU time so that they line up with the CPU scopes. There is a query pool per frame in flight, and a frame's
+	// results are read back when its slot next comes round, by which point its fence has been waited on, so reading
+	// them never stalls. Queries are only written while a profiling session or live capture is running.
+	class VulkanGPUProfiler
+	{
+	public:
+		void Init(Ref<VulkanDevice> device, uint32_t framesInFlight);
+		void Shutdown();
+
+		// call once the frame's command buffer has begun recording (and outside of any render pass)
+		void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+		// scopes must nest, and be closed within the frame they were opened in
+		void BeginScope(VkCommandBuffer commandBuffer, const char* name);
+		void EndScope(VkCommandBuffer commandBuffer);
+
+		// a copy of the name which lives as long as the profiler, for names that might not outlive a session
+		const char* InternName(const std::string& name);
+
+		bool IsSupported() const { return m_Supported; }
+		bool IsRecording() const { return m_Recording; }
+
+	private:
+		static constexpr uint32_t c_MaxQueriesPerFrame = 512;
+
+		struct GPUScope
+		{
+			const char* Name;
+			uint32_t BeginQuery;
+			uint32_t EndQuery;
+			uint32_t Depth;
+		};
+
+		struct FrameQueries
+		{
+			VkQueryPool QueryPool = VK_NULL_HANDLE;
+			uint32_t QueryCount = 0;
+			std::vector<GPUScope> Scopes;
+			int64_t CPUBeginTime = 0;
+		};
+
+		Ref<VulkanDevice> m_Device;
+		bool m_Supported = false;
+		bool m_Recording = false;
+
+		std::vector<FrameQueries> m_Frames;
+		uint32_t m_CurrentFrameIndex = 0;
+		std::vector<uint32_t> m_OpenScopes; // indices into the current frame's scopes
+		std::vector<uint64_t> m_Results;
+		uint64_t m_DroppedScopes = 0;
+
+		// conversion from GPU ticks to steady_clock nanoseconds
+		float m_TimestampPeriod = 1.0f; // nanoseconds per tick
+		uint64_t m_TimestampMask = ~0ull;
+		VkQueryPool m_CalibrationPool = VK_NULL_HANDLE;
+		uint64_t m_CalibrationTicks = 0;
+		int64_t m_CalibrationTime = 0;
+
+		std::unordered_set<std::string> m_InternedNames;
+
+		void Calibrate();
+		void CollectResults(FrameQueries& frame);
+		int64_t ToCPUTime(uint64_t ticks) const;
+	};
+
+}
@@ -4,6 +4,7 @@
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanTexture.h"
 #include "Zahra/Core/Application.h"
+#include "Zahra/Renderer/GPUProfiling.h"
 
 #include <backends/imgui_impl_glfw.h>
 #include <backends/imgui_impl_Vulkan.h>
@@ -103,6 +104,10 @@ namespace Zahra
 
 	void VulkanImGuiLayer::OnDetach()
 	{
+		// release any deferred descriptor sets before their pool is destroyed
+		vkDeviceWaitIdle(m_Swapchain->GetVkDevice());
+		m_Swapchain->FlushResourceFreeQueue(true);
+
 		ImGui_ImplVulkan_Shutdown();
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();		
@@ -151,6 +156,8 @@ namespace Zahra
 			ImGui::RenderPlatformWindowsDefault();
 		}
 
+		Z_PROFILE_GPU_SCOPE("ImGui");
+
 		VkClearValue clearColour = {{ 0.0f, 0.0f, 0.0f }};
 
 		VkRenderPassBeginInfo renderPassBeginInfo = {};
@@ -175,11 +182,13 @@ namespace Zahra
 
 	void VulkanImGuiLayer::DeregisterTexture(ImGuiTextureHandle& handle)
 	{
-		const auto& device = m_Swapchain->GetVkDevice();
-		vkDeviceWaitIdle(device);
+		VkDevice device = m_Swapchain->GetVkDevice();
 
-		const VkDescriptorSet descriptorSet = (VkDescriptorSet)handle;
-		vkFreeDescriptorSets(device, m_DescriptorPool, 1, &descriptorSet);
+		// the descriptor set may still be bound by frames in flight
+		m_Swapchain->SubmitResourceFree([device, descriptorPool = m_DescriptorPool, descriptorSet = (VkDescriptorSet)handle]()
+			{
+				vkFreeDescriptorSets(device, descriptorPool, 1, &descriptorSet);
+			});
 
 		handle = nullptr;
 	}
@@ -304,10 +313,13 @@ namespace Zahra
 
 	void VulkanImGuiLayer::Cleanup()
 	{
-		const auto& device = m_Swapchain->GetVkDevice();
-		vkDeviceWaitIdle(device);
-		vkDestroyFramebuffer(device, m_Framebuffer, nullptr);
-		vkDestroyImageView(device, m_LinearisedImageView, nullptr);
+		VkDevice device = m_Swapchain->GetVkDevice();
+
+		m_Swapchain->SubmitResourceFree([device, framebuffer = m_Framebuffer, imageView = m_LinearisedImageView]()
+			{
+				vkDestroyFramebuffer(device, framebuffer, nullptr);
+				vkDestroyImageView(device, imageView, nullptr);
+			});
 	}
 
 }
@@ -28,21 +28,27 @@ namespace Zahra
 
 	void VulkanImage2D::Cleanup()
 	{
-		auto& device = VulkanContext::GetCurrentVkDevice();
-		vkDeviceWaitIdle(device);
+		VkDevice device = VulkanContext::GetCurrentVkDevice();
 
 		if (m_Specification.CreatePixelBuffer)
 		{
-			vkUnmapMemory(device, m_PixelBufferMemory);
-			vkDestroyBuffer(device, m_PixelBuffer, nullptr);
-			vkFreeMemory(device, m_PixelBufferMemory, nullptr);
+			VulkanContext::SubmitResourceFree([device, buffer = m_PixelBuffer, memory = m_PixelBufferMemory]()
+				{
+					vkUnmapMemory(device, memory);
+					vkDestroyBuffer(device, buffer, nullptr);
+					vkFreeMemory(device, memory, nullptr);
+				});
+
 			m_PixelBufferMappedAddress = nullptr;
 		}
 
-		vkDestroySampler(device, m_Sampler, nullptr);
-		vkDestroyImageView(device, m_ImageView, nullptr);
-		vkFreeMemory(device, m_Memory, nullptr);
-		vkDestroyImage(device, m_Image, nullptr);
+		VulkanContext::SubmitResourceFree([device, sampler = m_Sampler, imageView = m_ImageView, memory = m_Memory, image = m_Image]()
+			{
+				vkDestroySampler(device, sampler, nullptr);
+				vkDestroyImageView(device, imageView, nullptr);
+				vkFreeMemory(device, memory, nullptr);
+				vkDestroyImage(device, image, nullptr);
+			});
 	}
 
 	void VulkanImage2D::Resize(uint32_t width, uint32_t height)
@@ -21,12 +21,13 @@ namespace Zahra
 
 	VulkanIndexBuffer::~VulkanIndexBuffer()
 	{
-		VkDevice& device = VulkanContext::GetCurrentVkDevice();
-
-		vkDeviceWaitIdle(device);
+		VkDevice device = VulkanContext::GetCurrentVkDevice();
 
-		vkDestroyBuffer(device, m_VulkanIndexBuffer, nullptr);
-		vkFreeMemory(device, m_VulkanIndexBufferMemory, nullptr);
+		VulkanContext::SubmitResourceFree([device, buffer = m_VulkanIndexBuffer, memory = m_VulkanIndexBufferMemory]()
+			{
+				vkDestroyBuffer(device, buffer, nullptr);
+				vkFreeMemory(device, memory, nullptr);
+			});
 
 		// TODO: decide if/when local data should be released
 		//m_IndexData.Release();
@@ -12,8 +12,8 @@ namespace Zahra
 		VulkanStaticMesh(MeshSpecification specification, const std::filesystem::path& filepath);
 		virtual ~VulkanStaticMesh();
 
-		virtual Ref<VertexBuffer> GetVertexBuffer() override { return m_VertexBuffer.As<VertexBuffer>(); }
-		virtual Ref<IndexBuffer> GetIndexBuffer() override { return m_IndexBuffer.As<IndexBuffer>(); }
+		virtual RefView<VertexBuffer> GetVertexBuffer() override { return m_VertexBuffer; }
+		virtual RefView<IndexBuffer> GetIndexBuffer() override { return m_IndexBuffer; }
 
 	private:
 		MeshSpecification m_Specification;
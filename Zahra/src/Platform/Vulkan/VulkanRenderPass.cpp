@@ -80,17 +80,18 @@ namespace Zahra
 
 	VulkanRenderPass::~VulkanRenderPass()
 	{
-		VkDevice& device = m_Swapchain->GetVkDevice();
-		vkDeviceWaitIdle(device);
+		VkDevice device = m_Swapchain->GetVkDevice();
 
 		m_ResourceManager.Reset();
 
 		DestroyFramebuffers();
-		
-		vkDestroyPipeline(device, m_Pipeline, nullptr);
-		vkDestroyPipelineLayout(device, m_PipelineLayout, nullptr);
 
-		vkDestroyRenderPass(device, m_RenderPass, nullptr);
+		m_Swapchain->SubmitResourceFree([device, pipeline = m_Pipeline, pipelineLayout = m_PipelineLayout, renderPass = m_RenderPass]()
+			{
+				vkDestroyPipeline(device, pipeline, nullptr);
+				vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+				vkDestroyRenderPass(device, renderPass, nullptr);
+			});
 	}
 
 	Ref<Framebuffer> VulkanRenderPass::GetRenderTarget()
@@ -578,13 +579,15 @@ namespace Zahra
 
 	void VulkanRenderPass::DestroyFramebuffers()
 	{
-		VkDevice& device = m_Swapchain->GetVkDevice();
-		vkDeviceWaitIdle(device);
+		VkDevice device = m_Swapchain->GetVkDevice();
 
-		for (auto& framebuffer : m_Framebuffers)
-		{
-			vkDestroyFramebuffer(device, framebuffer, nullptr);
-		}
+		m_Swapchain->SubmitResourceFree([device, framebuffers = std::move(m_Framebuffers)]()
+			{
+				for (auto& framebuffer : framebuffers)
+				{
+					vkDestroyFramebuffer(device, framebuffer, nullptr);
+				}
+			});
 
 		m_Framebuffers.clear();
 	}
@@ -74,6 +74,7 @@ namespace Zahra
 		const VkFramebuffer& GetVkFramebuffer() const;
 
 		const std::vector<VkClearValue> GetClearValues() const;
+		const std::vector<VkClearValue>& GetCachedClearValues() const { return m_ClearValues; }
 		const std::vector<VkClearAttachment>& GetClearAttachments() const { return m_ClearAttachments; }
 		const std::vector<VkClearRect>& GetClearRects() const { return m_ClearRects; }
 
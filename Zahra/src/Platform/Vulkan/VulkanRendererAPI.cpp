@@ -12,12 +12,15 @@ namespace Zahra
 	{
 		m_Swapchain = VulkanContext::Get()->GetSwapchain();
 		m_Device = m_Swapchain->GetDevice();
-		m_FramesInFlight = m_Swapchain->GetFramesInFlight();		
+		m_FramesInFlight = m_Swapchain->GetFramesInFlight();
+
+		m_GPUProfiler.Init(m_Device, m_FramesInFlight);
 	}
 
 	void VulkanRendererAPI::Shutdown()
 	{
-		
+		vkDeviceWaitIdle(m_Device->GetVkDevice());
+		m_GPUProfiler.Shutdown();
 	}
 
 	void VulkanRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -69,6 +72,8 @@ namespace Zahra
 		VulkanUtils::ValidateVkResult(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo),
 			"Vulkan command buffer failed to begin recording");
 		// TODO: reset descriptor pools?
+
+		m_GPUProfiler.BeginFrame(commandBuffer, m_Swapchain->GetFrameIndex());
 	}
 
 	void VulkanRendererAPI::EndFrame()
@@ -83,8 +88,8 @@ namespace Zahra
 	{
 		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
 
-		Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
-		std::vector<VkClearValue> clearValues = vulkanRenderPass->GetClearValues();
+		RefView<VulkanRenderPass> vulkanRenderPass = renderPass.AsView<VulkanRenderPass>();
+		const std::vector<VkClearValue>& clearValues = vulkanRenderPass->GetCachedClearValues();
 
 		VkExtent2D renderArea;
 		if (vulkanRenderPass->TargetSwapchain())
@@ -98,10 +103,16 @@ namespace Zahra
 		}
 		else
 		{
-			Ref<Framebuffer> renderTarget = vulkanRenderPass->GetSpecification().RenderTarget;
+			RefView<Framebuffer> renderTarget = vulkanRenderPass->GetSpecification().RenderTarget;
 			renderArea = { renderTarget->GetWidth(), renderTarget->GetHeight() };
 		}
 
+		if (m_GPUProfiler.IsRecording())
+		{
+			const std::string& name = vulkanRenderPass->GetSpecification().Name;
+			m_GPUProfiler.BeginScope(commandBuffer, m_GPUProfiler.InternName(name.empty() ? "Render Pass" : name));
+		}
+
 		VkRenderPassBeginInfo renderPassBeginInfo{};
 		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 		renderPassBeginInfo.renderPass = vulkanRenderPass->GetVkRenderPass();
@@ -146,7 +157,20 @@ namespace Zahra
 
 	void VulkanRendererAPI::EndRenderPass()
 	{
-		vkCmdEndRenderPass(m_Swapchain->GetCurrentDrawCommandBuffer());
+		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
+
+		vkCmdEndRenderPass(commandBuffer);
+		m_GPUProfiler.EndScope(commandBuffer);
+	}
+
+	void VulkanRendererAPI::BeginGPUScope(const char* name)
+	{
+		m_GPUProfiler.BeginScope(m_Swapchain->GetCurrentDrawCommandBuffer(), name);
+	}
+
+	void VulkanRendererAPI::EndGPUScope()
+	{
+		m_GPUProfiler.EndScope(m_Swapchain->GetCurrentDrawCommandBuffer());
 	}
 
 	void VulkanRendererAPI::Present()
@@ -157,9 +181,9 @@ namespace Zahra
 	void VulkanRendererAPI::Draw(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, uint32_t vertexCount)
 	{
 		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
-		Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
+		RefView<VulkanRenderPass> vulkanRenderPass = renderPass.AsView<VulkanRenderPass>();
 
-		VkBuffer vulkanVertexBufferArray[] = { vertexBuffer.As<VulkanVertexBuffer>()->GetVulkanBuffer() };
+		VkBuffer vulkanVertexBufferArray[] = { vertexBuffer.AsView<VulkanVertexBuffer>()->GetVulkanBuffer() };
 		VkDeviceSize offsets[] = { 0 };
 		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vulkanVertexBufferArray, offsets);
 
@@ -171,13 +195,13 @@ namespace Zahra
 	void VulkanRendererAPI::DrawIndexed(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, Ref<IndexBuffer>& indexBuffer, uint32_t indexCount, uint32_t startingIndex)
 	{
 		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
-		Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
+		RefView<VulkanRenderPass> vulkanRenderPass = renderPass.AsView<VulkanRenderPass>();
 
-		VkBuffer vulkanVertexBufferArray[] = { vertexBuffer.As<VulkanVertexBuffer>()->GetVulkanBuffer() };
+		VkBuffer vulkanVertexBufferArray[] = { vertexBuffer.AsView<VulkanVertexBuffer>()->GetVulkanBuffer() };
 		VkDeviceSize offsets[] = { 0 };
 		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vulkanVertexBufferArray, offsets);
 
-		VkBuffer vulkanIndexBuffer = indexBuffer.As<VulkanIndexBuffer>()->GetVulkanBuffer();
+		VkBuffer vulkanIndexBuffer = indexBuffer.AsView<VulkanIndexBuffer>()->GetVulkanBuffer();
 		vkCmdBindIndexBuffer(commandBuffer, vulkanIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
 		vulkanRenderPass->BindManagedResources(commandBuffer);
@@ -191,7 +215,7 @@ namespace Zahra
 	void VulkanRendererAPI::DrawMesh(Ref<RenderPass>& renderPass, Ref<Mesh>& mesh)
 	{
 		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
-		Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
+		RefView<VulkanRenderPass> vulkanRenderPass = renderPass.AsView<VulkanRenderPass>();
 
 		VkBuffer vulkanVertexBufferArray[] = { mesh->GetVertexBuffer().As<VulkanVertexBuffer>()->GetVulkanBuffer()};
 		VkDeviceSize offsets[] = { 0 };
@@ -208,7 +232,7 @@ namespace Zahra
 	void VulkanRendererAPI::DrawFullscreenTriangle(Ref<RenderPass>& renderPass)
 	{
 		VkCommandBuffer& commandBuffer = m_Swapchain->GetCurrentDrawCommandBuffer();
-		Ref<VulkanRenderPass> vulkanRenderPass = renderPass.As<VulkanRenderPass>();
+		RefView<VulkanRenderPass> vulkanRenderPass = renderPass.AsView<VulkanRenderPass>();
 
 		vulkanRenderPass->BindManagedResources(commandBuffer);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanGPUProfiler.h"
 #include "Platform/Vulkan/VulkanRenderPass.h"
 #include "Zahra/Renderer/RendererAPI.h"
 
@@ -31,6 +32,9 @@ namespace Zahra
 		virtual void BeginRenderPass(Ref<RenderPass>& renderPass, bool bindPipeline = true, bool clearAttachments = false) override;
 		virtual void EndRenderPass() override;
 
+		virtual void BeginGPUScope(const char* name) override;
+		virtual void EndGPUScope() override;
+
 		virtual void Draw(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, uint32_t vertexCount) override;
 		virtual void DrawIndexed(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, Ref<IndexBuffer>& indexBuffer, uint32_t indexCount = 0, uint32_t startingIndex = 0) override;
 		virtual void DrawMesh(Ref<RenderPass>& renderPass, Ref<Mesh>& mesh) override;
@@ -43,5 +47,7 @@ namespace Zahra
 		Ref<VulkanDevice> m_Device;
 
 		uint32_t m_FramesInFlight;
+
+		VulkanGPUProfiler m_GPUProfiler;
 	};
 }
@@ -116,9 +116,12 @@ namespace Zahra
 
 	VulkanShaderResourceManager::~VulkanShaderResourceManager()
 	{
-		VkDevice& device = VulkanContext::GetCurrentVkDevice();
-		vkDeviceWaitIdle(device);
-		vkDestroyDescriptorPool(device, m_DescriptorPool, nullptr);
+		VkDevice device = VulkanContext::GetCurrentVkDevice();
+
+		VulkanContext::SubmitResourceFree([device, descriptorPool = m_DescriptorPool]()
+			{
+				vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+			});
 	}
 
 	void VulkanShaderResourceManager::Set(const std::string& name, Ref<UniformBufferPerFrame> uniformBufferPerFrame)
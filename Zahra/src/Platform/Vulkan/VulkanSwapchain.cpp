@@ -30,6 +30,9 @@ namespace Zahra
 	{
 		vkDeviceWaitIdle(m_Device->m_LogicalDevice);
 
+		// nothing is in flight, so this is a free opportunity to release everything queued
+		FlushResourceFreeQueue(true);
+
 		Cleanup();
 
 		CreateSwapchain();
@@ -40,6 +43,15 @@ namespace Zahra
 
 	void VulkanSwapchain::Shutdown(VkInstance& instance)
 	{
+		vkDeviceWaitIdle(m_Device->m_LogicalDevice);
+
+		// freeing one resource may queue others, so keep going until nothing is left
+		while (!IsResourceFreeQueueEmpty())
+			FlushResourceFreeQueue(true);
+
+		// from here on nothing is in flight, so any later frees (while the device lives) run immediately
+		m_Initialised = false;
+
 		Cleanup();
 
 		for (uint32_t i = 0; i < m_FramesInFlight; i++)
@@ -77,6 +89,9 @@ namespace Zahra
 	{
 		vkWaitForFences(m_Device->m_LogicalDevice, 1, &m_InFlightFences[m_CurrentFrameIndex], VK_TRUE, UINT64_MAX);
 
+		// the frame which last used this slot has now finished on the GPU (and so have all before it)
+		FlushResourceFreeQueue();
+
 		VkResult result = vkAcquireNextImageKHR(m_Device->m_LogicalDevice, m_Swapchain, UINT64_MAX, m_ImageAvailableSemaphores[m_CurrentFrameIndex], VK_NULL_HANDLE, &m_CurrentImageIndex);
 
 		if (result == VK_ERROR_OUT_OF_DATE_KHR)
@@ -146,7 +161,53 @@ namespace Zahra
 		}
 
 		m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % m_FramesInFlight;
+		m_FrameCount++;
+
+	}
+
+	void VulkanSwapchain::SubmitResourceFree(std::function<void()>&& freeFunction)
+	{
+		// before the swapchain is up (or once it's shut down), nothing can be in flight
+		if (!m_Initialised)
+		{
+			Z_CORE_ASSERT(m_Device, "GPU resource freed after the Vulkan device was shut down");
+			freeFunction();
+			return;
+		}
 
+		std::scoped_lock<std::mutex> lock(m_ResourceFreeMutex);
+		m_ResourceFreeQueue.push_back({ m_FrameCount.load(), std::move(freeFunction) });
+	}
+
+	void VulkanSwapchain::FlushResourceFreeQueue(bool waitForAllFrames)
+	{
+		Z_PROFILE_FUNCTION();
+
+		std::vector<std::function<void()>> freeFunctions;
+		{
+			std::scoped_lock<std::mutex> lock(m_ResourceFreeMutex);
+
+			// a resource released while recording frame N may be referenced by any frame up to N
+			while (!m_ResourceFreeQueue.empty())
+			{
+				auto& front = m_ResourceFreeQueue.front();
+				if (!waitForAllFrames && front.Frame + m_FramesInFlight > m_FrameCount.load())
+					break;
+
+				freeFunctions.emplace_back(std::move(front.Function));
+				m_ResourceFreeQueue.pop_front();
+			}
+		}
+
+		// run outside the lock, since freeing one resource may release (and so queue) others
+		for (auto& freeFunction : freeFunctions)
+			freeFunction();
+	}
+
+	bool VulkanSwapchain::IsResourceFreeQueueEmpty()
+	{
+		std::scoped_lock<std::mutex> lock(m_ResourceFreeMutex);
+		return m_ResourceFreeQueue.empty();
 	}
 
 	VkCommandBuffer& VulkanSwapchain::GetDrawCommandBuffer(uint32_t index)
@@ -2,6 +2,10 @@
 
 #include "Platform/Vulkan/VulkanDevice.h"
 
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <vulkan/vulkan.h>
 
 namespace Zahra
@@ -41,6 +45,13 @@ namespace Zahra
 		const uint32_t GetFrameIndex() const { return m_CurrentFrameIndex; }
 		const uint32_t GetImageIndex() const { return m_CurrentImageIndex; }
 
+		// Queue the destruction of GPU resources which may still be referenced by frames in flight.
+		// It is run once the in-flight fence for the current frame has been waited on, i.e. once
+		// the GPU is certain to have finished with them, rather than stalling for vkDeviceWaitIdle.
+		void SubmitResourceFree(std::function<void()>&& freeFunction);
+		void FlushResourceFreeQueue(bool waitForAllFrames = false);
+		bool IsResourceFreeQueueEmpty();
+
 	private:
 		VkSwapchainKHR m_Swapchain = VK_NULL_HANDLE;
 
@@ -60,6 +71,15 @@ namespace Zahra
 
 		uint32_t m_FramesInFlight = 3;
 		uint32_t m_CurrentFrameIndex = 0;
+		std::atomic<uint64_t> m_FrameCount = 0; // total frames submitted, which tags queued resource frees
+
+		struct ResourceFree
+		{
+			uint64_t Frame;
+			std::function<void()> Function;
+		};
+		std::mutex m_ResourceFreeMutex;
+		std::deque<ResourceFree> m_ResourceFreeQueue;
 
 		VkSurfaceFormatKHR m_SurfaceFormat;
 		VkPresentModeKHR m_PresentationMode;
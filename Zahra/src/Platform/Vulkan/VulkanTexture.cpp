@@ -6,7 +6,7 @@
 
 namespace Zahra
 {
-	VulkanTexture2D::VulkanTexture2D(const TextureSpecification& specification, Buffer imageData)
+	VulkanTexture2D::VulkanTexture2D(const TextureSpecification& specification, SharedBuffer imageData)
 		: m_Specification(specification)
 	{
 		Z_CORE_ASSERT(imageData, "Empty buffer");
@@ -15,7 +15,8 @@ namespace Zahra
 		if (specification.GenerateMips)
 			m_MipLevels += (uint32_t)glm::floor(glm::log2((float)glm::max(m_Specification.Width, m_Specification.Height)));
 
-		m_LocalImageData = Buffer::Copy(imageData);
+		// shares the caller's storage, so the pixels are only copied once (into the staging buffer)
+		m_LocalImageData = std::move(imageData);
 		CreateImageAndDescriptorInfo();
 	}
 
@@ -48,10 +49,11 @@ namespace Zahra
 		{
 			uint64_t pixelCount = m_Specification.Width * m_Specification.Height;
 			uint64_t pixelBytes = 4; // assuming srgba
-			m_LocalImageData.Allocate(pixelCount * pixelBytes);
+			m_LocalImageData = SharedBuffer::Allocate(pixelCount * pixelBytes);
+			byte* pixels = m_LocalImageData.GetMutableData();
 			for (uint64_t offset = 0; offset < pixelCount * pixelBytes; offset += pixelBytes)
 			{
-				m_LocalImageData.Write(&colour, pixelBytes, offset);
+				memcpy(pixels + offset, &colour, pixelBytes);
 			}
 		}
 
@@ -60,9 +62,7 @@ namespace Zahra
 
 	VulkanTexture2D::~VulkanTexture2D()
 	{
-		VkDevice device = VulkanContext::GetCurrentVkDevice();
-		vkDeviceWaitIdle(device);
-
+		// the image defers its own destruction until frames in flight are done with it
 		m_Image.Reset();
 		m_LocalImageData.Release();
 	}
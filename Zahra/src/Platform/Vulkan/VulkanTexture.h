@@ -11,7 +11,7 @@ namespace Zahra
 	class VulkanTexture2D : public Texture2D
 	{
 	public:
-		VulkanTexture2D(const TextureSpecification& specification, Buffer imageData);
+		VulkanTexture2D(const TextureSpecification& specification, SharedBuffer imageData);
 		VulkanTexture2D(Ref<VulkanImage2D>& image);
 		VulkanTexture2D(const TextureSpecification& specification, uint32_t colour);
 		virtual ~VulkanTexture2D() override;
@@ -28,7 +28,7 @@ namespace Zahra
 		VkDescriptorImageInfo& GetVkDescriptorImageInfo() { return m_DescriptorImageInfo; }
 
 	private:
-		Buffer m_LocalImageData;
+		SharedBuffer m_LocalImageData;
 		
 		uint32_t m_MipLevels;
 		TextureSpecification m_Specification{};
@@ -18,12 +18,13 @@ namespace Zahra
 
 	VulkanUniformBuffer::~VulkanUniformBuffer()
 	{
-		VkDevice& device = VulkanContext::GetCurrentVkDevice();
+		VkDevice device = VulkanContext::GetCurrentVkDevice();
 
-		vkDeviceWaitIdle(device);
-
-		vkDestroyBuffer(device, m_VulkanBuffer, nullptr);
-		vkFreeMemory(device, m_VulkanBufferMemory, nullptr);
+		VulkanContext::SubmitResourceFree([device, buffer = m_VulkanBuffer, memory = m_VulkanBufferMemory]()
+			{
+				vkDestroyBuffer(device, buffer, nullptr);
+				vkFreeMemory(device, memory, nullptr);
+			});
 
 		m_Data.Release();
 	}
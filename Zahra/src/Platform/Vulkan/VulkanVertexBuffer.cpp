@@ -20,12 +20,13 @@ namespace Zahra
 	
 	VulkanVertexBuffer::~VulkanVertexBuffer()
 	{
-		VkDevice& device = VulkanContext::GetCurrentVkDevice();
-
-		vkDeviceWaitIdle(device);
+		VkDevice device = VulkanContext::GetCurrentVkDevice();
 
-		vkDestroyBuffer(device, m_VulkanVertexBuffer, nullptr);
-		vkFreeMemory(device, m_VulkanVertexBufferMemory, nullptr);
+		VulkanContext::SubmitResourceFree([device, buffer = m_VulkanVertexBuffer, memory = m_VulkanVertexBufferMemory]()
+			{
+				vkDestroyBuffer(device, buffer, nullptr);
+				vkFreeMemory(device, memory, nullptr);
+			});
 
 		m_VertexData.Release();
 	}
@@ -7,23 +7,36 @@
 
 namespace Zahra
 {
+	// headless apps have no window, and so never receive input
+	static GLFWwindow* GetInputWindow()
+	{
+		Application& app = Application::Get();
+		return app.IsHeadless() ? nullptr : app.GetWindow().GetWindowHandle();
+	}
+
 	bool Input::IsKeyPressed(KeyCode keycode)
 	{
-		auto window = Application::Get().GetWindow().GetWindowHandle();
+		auto window = GetInputWindow();
+		if (!window) return false;
+
 		auto state = glfwGetKey(window, static_cast<int32_t>(keycode));
 		return state == GLFW_PRESS;
 	}
 
 	bool Input::IsMouseButtonPressed(MouseCode button)
 	{
-		auto window = Application::Get().GetWindow().GetWindowHandle();
+		auto window = GetInputWindow();
+		if (!window) return false;
+
 		auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
 		return state == GLFW_PRESS;
 	}
 
 	std::pair<float, float> Input::GetMousePos()
 	{
-		auto window = Application::Get().GetWindow().GetWindowHandle();
+		auto window = GetInputWindow();
+		if (!window) return { .0f, .0f };
+
 		double x, y;
 		glfwGetCursorPos(window, &x, &y);
 		return std::make_pair((float)x,(float)y);
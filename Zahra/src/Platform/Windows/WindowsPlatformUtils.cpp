@@ -10,6 +10,8 @@
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
 
+#include <chrono>
+
 namespace Zahra
 {
 	// NOTE: calls new, so need to manually free the output after use
@@ -25,7 +27,9 @@ namespace Zahra
 
 	float Time::GetTime()
 	{
-		return (float)glfwGetTime();
+		// measured independently of GLFW, which isn't initialised in headless apps
+		static const auto s_StartTime = std::chrono::steady_clock::now();
+		return std::chrono::duration<float>(std::chrono::steady_clock::now() - s_StartTime).count();
 	}
 
 	std::filesystem::path FileDialogs::ChooseDirectory()
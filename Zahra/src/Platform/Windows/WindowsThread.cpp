@@ -9,7 +9,6 @@ namespace Zahra
 
 		std::wstring wName(name.begin(), name.end());
 		SetThreadDescription(threadHandle, wName.c_str());
-		SetThreadAffinityMask(threadHandle, 8);
 	}
 
 }
@@ -6,15 +6,23 @@
 #include "Zahra/Core/Application.h"
 #include "Zahra/Core/Assert.h"
 #include "Zahra/Core/Buffer.h"
+#include "Zahra/Core/FrameAllocator.h"
 #include "Zahra/Core/UUID.h"
+#include "Zahra/Core/UUIDMap.h"
 #include "Zahra/Core/Input.h"
+#include "Zahra/Core/JobSystem.h"
 #include "Zahra/Core/KeyCodes.h"
 #include "Zahra/Core/Layer.h"
 #include "Zahra/Core/Log.h"
+#include "Zahra/Core/MainThreadQueue.h"
 #include "Zahra/Core/Memory.h"
+#include "Zahra/Core/MemoryBudget.h"
 #include "Zahra/Core/MouseCodes.h"
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Core/PoolAllocator.h"
 #include "Zahra/Core/Ref.h"
 #include "Zahra/Core/Scope.h"
+#include "Zahra/Core/Task.h"
 #include "Zahra/Core/Thread.h"
 #include "Zahra/Core/Timer.h"
 
@@ -28,6 +36,10 @@
 #include "Zahra/Assets/RuntimeAssetManager.h"
 
 //------------DEBUG--------------------
+#include "Zahra/Debug/FrameStats.h"
+#include "Zahra/Debug/HeapProfiler.h"
+#include "Zahra/Debug/Metrics.h"
+#include "Zahra/Debug/ProfilerPanel.h"
 #include "Zahra/Debug/Profiling.h"
 
 //------------IMGUI--------------------
@@ -42,6 +54,7 @@
 #include "Zahra/Renderer/Cameras/EditorCamera.h"
 #include "Zahra/Renderer/Cameras/SceneCamera.h"
 #include "Zahra/Renderer/Framebuffer.h"
+#include "Zahra/Renderer/GPUProfiling.h"
 #include "Zahra/Renderer/Image.h"
 #include "Zahra/Renderer/IndexBuffer.h"
 #include "Zahra/Renderer/Material.h"
@@ -1,6 +1,7 @@
 #include "zpch.h"
 #include "AssetLoader.h"
 
+#include "Zahra/Core/Task.h"
 #include "Zahra/Renderer/Texture.h"
 
 namespace Zahra
@@ -15,6 +16,12 @@ namespace Zahra
 		//{AssetType::Script, }
 	};
 
+	using AsyncAssetLoadingFunction = std::function<Task<Ref<Asset>>(const AssetHandle&, const AssetMetadata&)>;
+	static std::map<AssetType, AsyncAssetLoadingFunction> s_AsyncAssetLoadingFunctions =
+	{
+		{ AssetType::Texture2D, TextureLoader::LoadTexture2DAssetAsync },
+	};
+
 	Ref<Asset> AssetLoader::LoadAssetFromSource(const AssetHandle& handle, const AssetMetadata& metadata)
 	{
 		auto& search = s_AssetLoadingFunctions.find(metadata.Type);
@@ -26,4 +33,14 @@ namespace Zahra
 
 		return search->second(handle, metadata);
 	}
+
+	Task<Ref<Asset>> AssetLoader::LoadAssetFromSourceAsync(const AssetHandle& handle, const AssetMetadata& metadata)
+	{
+		auto search = s_AsyncAssetLoadingFunctions.find(metadata.Type);
+		if (search != s_AsyncAssetLoadingFunctions.end())
+			return search->second(handle, metadata);
+
+		// no asynchronous loader for this type yet, so load it on the main thread next frame
+		return Async::RunOnMainThread([handle, metadata]() { return LoadAssetFromSource(handle, metadata); });
+	}
 }
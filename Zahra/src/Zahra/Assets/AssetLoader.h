@@ -5,9 +5,16 @@
 
 namespace Zahra
 {
+	template<typename T>
+	class Task;
+
 	class AssetLoader
 	{
 	public:
 		static Ref<Asset> LoadAssetFromSource(const AssetHandle& handle, const AssetMetadata& metadata);
+
+		// does the slow part (e.g. reading and decoding files) on a worker thread where the asset type allows, and
+		// completes on the main thread, so the caller's frame isn't held up (include Zahra/Core/Task.h to use the result)
+		static Task<Ref<Asset>> LoadAssetFromSourceAsync(const AssetHandle& handle, const AssetMetadata& metadata);
 	};
 }
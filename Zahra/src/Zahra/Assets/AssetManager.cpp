@@ -1,7 +1,12 @@
 #include "zpch.h"
 #include "AssetManager.h"
 
+#include "Zahra/Core/Task.h"
+
 namespace Zahra
 {
-
+	Task<Ref<Asset>> AssetManager::GetAssetAsync(AssetHandle handle)
+	{
+		return Project::GetActive()->GetAssetManager()->GetAssetAsync(handle);
+	}
 }
@@ -13,5 +13,13 @@ namespace Zahra
 		{
 			return Project::GetActive()->GetAssetManager()->GetAsset(handle).As<T>();
 		}
+
+		// starts loading the asset without blocking (on the main thread only), see EditorAssetManager::GetAssetAsync
+		static Task<Ref<Asset>> GetAssetAsync(AssetHandle handle);
+
+		static bool IsAssetLoaded(AssetHandle handle)
+		{
+			return Project::GetActive()->GetAssetManager()->IsAssetLoaded(handle);
+		}
 	};
 }
@@ -6,10 +6,14 @@ namespace Zahra
 {
 	using AssetMap = std::map<AssetHandle, Ref<Asset>>;
 
+	template<typename T>
+	class Task;
+
 	class AssetManagerBase : public RefCounted
 	{
 	public:
 		virtual Ref<Asset> GetAsset(AssetHandle handle) = 0;
+		virtual Task<Ref<Asset>> GetAssetAsync(AssetHandle handle) = 0;
 		//virtual const AssetMetadata& GetMetadata(AssetHandle handle) const = 0;
 
 		//virtual AssetHandle AddAsset(AssetType type) = 0;
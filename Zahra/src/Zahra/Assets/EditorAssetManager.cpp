@@ -2,6 +2,7 @@
 #include "EditorAssetManager.h"
 
 #include "Zahra/Assets/AssetLoader.h"
+#include "Zahra/Core/Task.h"
 #include "Zahra/ImGui/ImGuiLayer.h"
 #include "Zahra/Projects/Project.h"
 
@@ -11,6 +12,14 @@ namespace Zahra
 {
 	static const AssetMetadata s_NullMetadata;
 
+	struct EditorAssetManager::PendingLoad
+	{
+		Task<Ref<Asset>> Load;
+	};
+
+	EditorAssetManager::EditorAssetManager() = default;
+	EditorAssetManager::~EditorAssetManager() = default;
+
 	Ref<Asset> EditorAssetManager::GetAsset(AssetHandle handle)
 	{
 		const auto& metadata = GetMetadata(handle);
@@ -22,6 +31,45 @@ namespace Zahra
 			return asset;
 		
 		asset = AssetLoader::LoadAssetFromSource(handle, metadata);
+		OnAssetLoaded(handle, metadata, asset);
+
+		return asset;
+	}
+
+	Task<Ref<Asset>> EditorAssetManager::GetAssetAsync(AssetHandle handle)
+	{
+		const auto& metadata = GetMetadata(handle);
+		if (!metadata) // not in registry
+			return Task<Ref<Asset>>::FromValue(nullptr);
+
+		Ref<Asset> asset = GetAssetIfLoaded(handle);
+		if (asset) // asset already loaded
+			return Task<Ref<Asset>>::FromValue(asset);
+
+		auto pending = m_PendingLoads.find(handle);
+		if (pending != m_PendingLoads.end())
+			return pending->second->Load;
+
+		Ref<EditorAssetManager> assetManager = this;
+		Task<Ref<Asset>> load = AssetLoader::LoadAssetFromSourceAsync(handle, metadata)
+			.ThenOnMainThread([assetManager, handle, metadata](Ref<Asset>& loadedAsset)
+			{
+				assetManager->m_PendingLoads.erase(handle);
+
+				// the asset may have been loaded synchronously in the meantime, in which case keep that one
+				if (Ref<Asset> existing = assetManager->GetAssetIfLoaded(handle))
+					return existing;
+
+				assetManager->OnAssetLoaded(handle, metadata, loadedAsset);
+				return loadedAsset;
+			});
+
+		m_PendingLoads[handle] = CreateScope<PendingLoad>(PendingLoad{ load });
+		return load;
+	}
+
+	void EditorAssetManager::OnAssetLoaded(AssetHandle handle, const AssetMetadata& metadata, Ref<Asset> asset)
+	{
 		if (!asset)
 			Z_CORE_ERROR("EditorAssetManager failed to load asset '{}'", metadata.Filepath.string().c_str());
 
@@ -29,8 +77,6 @@ namespace Zahra
 
 		// register imgui handle for texture asset thumbnail
 		RegisterThumbnail(handle, metadata, asset);
-
-		return asset;
 	}
 
 	const AssetMetadata& EditorAssetManager::GetMetadata(AssetHandle handle) const
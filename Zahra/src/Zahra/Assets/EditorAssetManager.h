@@ -11,7 +11,14 @@ namespace Zahra
 	class EditorAssetManager : public AssetManagerBase
 	{
 	public:
+		EditorAssetManager();
+		~EditorAssetManager();
+
 		virtual Ref<Asset> GetAsset(AssetHandle handle) override;
+
+		// Must be called on the main thread. Loads the asset without blocking, if it isn't loaded already; it is
+		// added to the loaded assets on the main thread, once complete. Repeated calls share one load.
+		virtual Task<Ref<Asset>> GetAssetAsync(AssetHandle handle) override;
 		//virtual const AssetMetadata& GetMetadata(AssetHandle handle) const override;
 		const AssetMetadata& GetMetadata(AssetHandle handle) const;
 
@@ -27,9 +34,13 @@ namespace Zahra
 		AssetMap m_LoadedAssets;
 		AssetRegistry m_AssetRegistry;
 
+		struct PendingLoad; // wraps a Task, defined in the .cpp to keep Task.h out of this header
+		std::map<AssetHandle, Scope<PendingLoad>> m_PendingLoads;
+
 		ThumbnailMap m_ThumbnailHandles;
 
 		Ref<Asset> GetAssetIfLoaded(AssetHandle handle) const;
+		void OnAssetLoaded(AssetHandle handle, const AssetMetadata& metadata, Ref<Asset> asset);
 
 		void RegisterThumbnail(AssetHandle handle, const AssetMetadata& metadata, Ref<RefCounted> asset);
 	};
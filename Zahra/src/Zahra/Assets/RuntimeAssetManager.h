@@ -8,6 +8,7 @@ namespace Zahra
 	{
 	public:
 		virtual Ref<Asset> GetAsset(AssetHandle handle) override;
+		virtual Task<Ref<Asset>> GetAssetAsync(AssetHandle handle) override;
 		//virtual const AssetMetadata& GetMetadata(AssetHandle handle) const override;
 
 		virtual bool IsAssetHandleValid(AssetHandle handle) const override;
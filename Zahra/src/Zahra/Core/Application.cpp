@@ -1,14 +1,22 @@
 #include "zpch.h"
 #include "Application.h"
 
+#include "Zahra/Core/FrameAllocator.h"
 #include "Zahra/Core/Input.h"
+#include "Zahra/Core/JobSystem.h"
 #include "Zahra/Core/Memory.h"
+#include "Zahra/Core/MemoryBudget.h"
 #include "Zahra/Core/Timer.h"
+#include "Zahra/Debug/FrameStats.h"
+#include "Zahra/Debug/HeapProfiler.h"
 #include "Zahra/Projects/Project.h"
 #include "Zahra/Renderer/Renderer.h"
 #include "Zahra/Scripting/ScriptEngine.h"
 #include "Zahra/Utils/PlatformUtils.h"
 
+#include <chrono>
+#include <thread>
+
 namespace Zahra
 {
 	Application* Application::s_Instance = nullptr;
@@ -23,16 +31,49 @@ namespace Zahra
 		Z_CORE_ASSERT(!s_Instance, "Application already exists");
 		s_Instance = this;
 
+		Z_PROFILE_THREAD("Main");
+
+		Allocator::SetSamplingInterval(m_Specification.MemoryTrackingSampleInterval);
+
+		for (auto& [category, limit] : m_Specification.MemoryBudgets)
+			MemoryBudget::Set(category, limit);
+
+		if (!m_Specification.HeapProfilePath.empty())
+			Z_PROFILE_HEAP_BEGIN_SESSION(m_Specification.HeapProfilePath.string());
+
+		JobSystem::Init(m_Specification.WorkerThreadCount);
+		FrameStats::Init(m_Specification.FrameStatsHistorySize);
+
+		Metrics::SetSnapshotInterval(m_Specification.MetricsSnapshotInterval);
+		if (!m_Specification.MetricsExportPath.empty())
+			Metrics::BeginExport(m_Specification.MetricsExportPath, m_Specification.MetricsFormat);
+
+		Z_CORE_ASSERT(m_Specification.FixedTimestep > .0f, "Fixed timestep must be positive");
+		Z_CORE_ASSERT(m_Specification.MaxFixedStepsPerFrame > 0, "Must allow at least one fixed step per frame");
+
 		Project::New();
 
+		if (IsHeadless())
+		{
+			Z_CORE_INFO("Running headless: no window, renderer or ImGui");
+
+			// nothing is ever in flight, so a single arena suffices
+			FrameAllocator::Init(1, m_Specification.FrameAllocatorSize);
+
+			ScriptEngine::InitCore();
+			return;
+		}
+
 		Renderer::SetConfig(m_Specification.RendererConfig);
 
 		// TODO: other WindowProperties?
 		m_Window = Window::Create(WindowProperties(specification.Name));
-		m_Window->SetEventCallback(Z_BIND_EVENT_FN(Application::OnEvent));
+		m_Window->SetEventCallback(Z_BIND_EVENT_FN(Application::QueueEvent));
 		
 		Renderer::Init();
 
+		FrameAllocator::Init(Renderer::GetFramesInFlight(), m_Specification.FrameAllocatorSize);
+
 		ScriptEngine::InitCore();
 
 		if (m_Specification.ImGuiConfig.Enabled)
@@ -46,38 +87,110 @@ namespace Zahra
 	
 	Application::~Application()
 	{
+		// finish any outstanding jobs before the data they reference goes away
+		JobSystem::Shutdown();
+
 		// should clean up all content prior to shutting down core systems... right?
 		m_LayerStack.PopAll();
 
 		ScriptEngine::Shutdown();
-		Renderer::Shutdown();
+		FrameAllocator::Shutdown();
+
+		if (!IsHeadless())
+			Renderer::Shutdown();
+
+		Metrics::EndExport();
+		HeapProfiler::EndSession();
 	}
 
 	void Application::Run()
 	{
 		Z_CORE_INFO("Start of run loop");
 
+		const HeadlessConfig& headless = m_Specification.Headless;
+		m_PreviousFrameStartTime = Time::GetTime();
+
 		while (m_Running)
 		{
-			// Compute frame time
+			// Compute frame time (clamping pathologically long frames, e.g. after hitting a breakpoint or dragging the window)
 			float frameStartTime = Time::GetTime();
-			//float dt = frameStartTime - m_PreviousFrameStartTime; // actual time step
-			float dt = glm::min<float>(frameStartTime - m_PreviousFrameStartTime, 0.0333f); // regularised time step (for numerical stability)
+			float dt = glm::min<float>(frameStartTime - m_PreviousFrameStartTime, 0.25f);
 			m_PreviousFrameStartTime = frameStartTime;
 
+			FrameStats::BeginFrame();
+			Z_PROFILE_FRAME();
+
+			if (IsHeadless())
+			{
+				// uncapped headless runs step the simulation once per frame, as fast as possible
+				if (headless.TargetFrameRate <= .0f)
+					dt = m_Specification.FixedTimestep;
+
+				FrameAllocator::BeginFrame(0);
+
+				HeapProfiler::OnFrame();
+				MemoryBudget::Update();
+
+				FlushCommandQueue();
+
+				{
+					FramePhaseTimer timer(FramePhase::FixedUpdate);
+					FixedUpdate(dt);
+				}
+
+				{
+					FramePhaseTimer timer(FramePhase::LayerUpdate);
+					for (Layer* layer : m_LayerStack)
+						layer->OnUpdate(dt);
+				}
+
+				if (headless.MaxFrames > 0 && m_FrameCount + 1 >= headless.MaxFrames)
+					m_Running = false;
+
+				if (headless.TargetFrameRate > .0f)
+				{
+					float remaining = 1.0f / headless.TargetFrameRate - (Time::GetTime() - frameStartTime);
+					if (remaining > .0f)
+						std::this_thread::sleep_for(std::chrono::duration<float>(remaining));
+				}
+
+				EndFrame(frameStartTime);
+				continue;
+			}
+
+			// anything allocated the last time this frame index was in flight is now safe to discard
+			FrameAllocator::BeginFrame(Renderer::GetCurrentFrameIndex());
+
+			HeapProfiler::OnFrame();
+			MemoryBudget::Update();
+
 			FlushCommandQueue();
 
-			m_Window->PollEvents();
+			{
+				FramePhaseTimer timer(FramePhase::EventPoll);
+				m_Window->PollEvents();
+				m_EventQueue.Dispatch(Z_BIND_EVENT_FN(Application::OnEvent));
+			}
 
 			if (!m_Minimised)
 			{
 				Renderer::BeginFrame();
 
-				for (Layer* layer : m_LayerStack)
-					layer->OnUpdate(dt);
+				{
+					FramePhaseTimer timer(FramePhase::FixedUpdate);
+					FixedUpdate(dt);
+				}
+
+				{
+					FramePhaseTimer timer(FramePhase::LayerUpdate);
+					for (Layer* layer : m_LayerStack)
+						layer->OnUpdate(dt);
+				}
 
 				if (m_Specification.ImGuiConfig.Enabled)
 				{
+					FramePhaseTimer timer(FramePhase::ImGui);
+
 					m_ImGuiLayer->Begin();
 
 					for (Layer* layer : m_LayerStack)
@@ -86,31 +199,86 @@ namespace Zahra
 					m_ImGuiLayer->End();
 				}
 
-				Renderer::EndFrame();
-				Renderer::Present();
+				{
+					FramePhaseTimer timer(FramePhase::EndFrame);
+					Renderer::EndFrame();
+				}
+
+				{
+					FramePhaseTimer timer(FramePhase::Present);
+					Renderer::Present();
+				}
 			}
+
+			EndFrame(frameStartTime);
 		}
 
 		Z_CORE_INFO("End of run loop");
 
-		m_Window->WriteConfig();
+		if (m_Window)
+			m_Window->WriteConfig();
 	}
 
-	void Application::SubmitToMainThread(const std::function<void()>& command)
+	void Application::FixedUpdate(float dt)
 	{
-		std::scoped_lock<std::mutex> lock(m_MainThreadCommandQueueMutex);
+		Z_PROFILE_FUNCTION();
+
+		// advance the simulation in fixed steps, independently of the frame rate
 
-		m_MainThreadCommandQueue.emplace_back(command);
+		const float fixedTimestep = m_Specification.FixedTimestep;
+		m_FixedStepAccumulator += dt;
+
+		uint32_t steps = 0;
+		while (m_FixedStepAccumulator >= fixedTimestep && steps < m_Specification.MaxFixedStepsPerFrame)
+		{
+			for (Layer* layer : m_LayerStack)
+				layer->OnFixedUpdate(fixedTimestep);
+
+			m_FixedStepAccumulator -= fixedTimestep;
+			steps++;
+		}
+
+		// too far behind to catch up: drop the backlog (keeping the phase), rather than falling further behind
+		if (m_FixedStepAccumulator >= fixedTimestep)
+			m_FixedStepAccumulator = glm::mod(m_FixedStepAccumulator, fixedTimestep);
+
+		m_FixedStepInterpolation = m_FixedStepAccumulator / fixedTimestep;
 	}
 
-	void Application::FlushCommandQueue()
+	void Application::EndFrame(float frameStartTime)
 	{
-		std::scoped_lock<std::mutex> lock(m_MainThreadCommandQueueMutex);
+		FrameStats::EndFrame();
+
+		static MetricHistogram& frameTime = Metrics::GetHistogram("frame.time_ms", MetricHistogram::ExponentialBounds(.5, 1.25, 32));
+		static MetricGauge& liveMemory = Metrics::GetGauge("memory.live_bytes");
+
+		frameTime.Record((Time::GetTime() - frameStartTime) * 1000.0f);
+
+		AllocationStats allocationStats = Memory::GetAllocationStats();
+		liveMemory.Set((double)(allocationStats.TotalAllocated - allocationStats.TotalFreed));
+
+		// Allocator::Free can't safely log, so report any frees it has ignored from here
+		static size_t reportedInvalidFrees = 0;
+		if (allocationStats.InvalidFreeCount != reportedInvalidFrees)
+		{
+			Z_CORE_ERROR("Ignored {0} free(s) of memory that was already freed, or not allocated by the tracked allocator",
+				allocationStats.InvalidFreeCount - reportedInvalidFrees);
+			reportedInvalidFrees = allocationStats.InvalidFreeCount;
+		}
 
-		for (auto& command : m_MainThreadCommandQueue)
-			command();
+		Metrics::EndFrame(m_FrameCount);
 
-		m_MainThreadCommandQueue.clear();
+		m_FrameCount++;
+	}
+
+	void Application::FlushCommandQueue()
+	{
+		m_MainThreadQueue.Flush(m_Specification.MainThreadCommandBudget);
+	}
+
+	void Application::QueueEvent(Event& e)
+	{
+		m_EventQueue.Push(e);
 	}
 
 	void Application::OnEvent(Event& e)
@@ -2,9 +2,12 @@
 
 #include "Zahra/Core/Defines.h"
 #include "Zahra/Core/LayerStack.h"
+#include "Zahra/Core/MainThreadQueue.h"
 #include "Zahra/Core/Window.h"
+#include "Zahra/Debug/Metrics.h"
 #include "Zahra/Events/ApplicationEvent.h"
 #include "Zahra/Events/Event.h"
+#include "Zahra/Events/EventQueue.h"
 #include "Zahra/ImGui/ImGuiLayer.h"
 #include "Zahra/Renderer/RendererConfig.h"
 
@@ -61,6 +64,27 @@ namespace Zahra
 		uint32_t MinBoundTextureSlots = 1; /**< @brief How many texture binding slots does the app need access to? */
 	};
 
+	/**
+	 * @brief Configuration for running an application without a window, renderer or ImGui overlay.
+	 *
+	 * Intended for dedicated simulation instances and automated performance runs on machines with no display
+	 * or GPU. Layers are still updated every frame, but must not touch the Renderer, Window or ImGui.
+	 */
+	struct HeadlessConfig
+	{
+		bool Enabled = false; /**< @brief Skip creating the window and initialising the Renderer and ImGui */
+
+		/**
+		 * @brief Frames per second to pace the run loop to.
+		 *
+		 * If 0, the loop runs uncapped, and rather than following wall-clock time each frame advances the
+		 * simulation by exactly one fixed timestep (so results are deterministic and as fast as the CPU allows).
+		 */
+		float TargetFrameRate = .0f;
+
+		uint64_t MaxFrames = 0; /**< @brief Exit the run loop after this many frames (0 runs until Exit is called) */
+	};
+
 	/**
 	 * @brief Contains the data needed to specify construction of an instance of Application.
 	 */
@@ -82,6 +106,20 @@ namespace Zahra
 		GPURequirements GPURequirements; /**< @brief The app's minimal GPU requirement data */
 
 		ImGuiLayerConfig ImGuiConfig;  /**< @brief App-specific configuration data for the engine's ImGui overlay */
+		HeadlessConfig Headless; /**< @brief Run without a window or renderer, see HeadlessConfig */
+
+		uint64_t FrameAllocatorSize = 1024 * 1024; /**< @brief Size (in bytes) of each per-frame arena used by the FrameAllocator */
+		uint32_t MemoryTrackingSampleInterval = 1; /**< @brief When memory tracking is enabled, only record every Nth allocation (1 records everything) */
+		uint32_t WorkerThreadCount = 0; /**< @brief Number of JobSystem worker threads (0 picks one per hardware thread, less one for the main thread) */
+		float FixedTimestep = 1.0f / 60.0f; /**< @brief Duration (in seconds) of each simulation step, see Layer::OnFixedUpdate */
+		uint32_t MaxFixedStepsPerFrame = 5; /**< @brief Cap on simulation steps per frame, beyond which the backlog is dropped (so slow frames can't spiral) */
+		float MainThreadCommandBudget = .0f; /**< @brief Time limit (in seconds) on running main thread commands each frame, beyond which the rest wait for the next frame (0 for no limit) */
+		uint32_t FrameStatsHistorySize = 1024; /**< @brief Number of recent frames kept for percentile statistics, see FrameStats */
+		uint32_t MetricsSnapshotInterval = 1; /**< @brief Take a Metrics snapshot every N frames (counters and histograms then cover all N) */
+		std::filesystem::path MetricsExportPath; /**< @brief If set, stream every Metrics snapshot to this file (or named pipe) from startup */
+		MetricsExportFormat MetricsFormat = MetricsExportFormat::CSV; /**< @brief Format of the metrics stream, if any */
+		std::filesystem::path HeapProfilePath; /**< @brief If set, run a HeapProfiler session from startup to shutdown, written to this file (requires Z_TRACK_MEMORY) */
+		std::map<std::string, uint64_t> MemoryBudgets; /**< @brief Limits (in bytes) on live heap memory per allocation category, see MemoryBudget */
 	};
 
 	/**
@@ -105,13 +143,20 @@ namespace Zahra
 
 		void Run(); /**< @brief This is called by the main function, beginning the application's runtime loop */
 
-		void SubmitToMainThread(const std::function<void()>& command); /**< @brief Called to submit a command to be run on the application's main thread, at the top of the next frame. */
+		/**
+		 * @brief Submit a command to be run on the application's main thread, at the top of the next frame.
+		 *
+		 * Safe to call from any thread (including from within a command), and never blocks.
+		 */
+		template<typename F>
+		void SubmitToMainThread(F&& command) { m_MainThreadQueue.Submit(std::forward<F>(command)); }
 
 		/**
 		 * @brief A callback function to handle event data coming from the OS, e.g. user input.
 		 * 
-		 * At the top of each frame this function will be called for each queued
-		 * event (this should be handled by the chosen windowing library).
+		 * Events are queued as the windowing library reports them, then (once polling
+		 * has finished, near the top of each frame) this function is called for each
+		 * queued event in turn.
 		 * 
 		 * @param e The polled Event.
 		 */
@@ -123,18 +168,32 @@ namespace Zahra
 		static inline Application& Get() { return *s_Instance; }  /**< @brief Retrieve the static Application (child) instance */
 
 		const ApplicationSpecification& GetSpecification() const { return m_Specification; } /**< @brief Retrieve this instance's spec data */
-		inline Window& GetWindow() { return *m_Window; } /**< @brief Retrieve the current Window instance */
+		inline Window& GetWindow() { Z_CORE_ASSERT(m_Window, "Headless applications have no window"); return *m_Window; } /**< @brief Retrieve the current Window instance */
+		bool IsHeadless() const { return m_Specification.Headless.Enabled; } /**< @brief Is this app running without a window or renderer? */
+		uint64_t GetFrameCount() const { return m_FrameCount; } /**< @brief Number of frames completed since the run loop began */
 		ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; } /**< @brief Retrieve the ImGuiLayer representing the engine's primary UI overlay */
 
 		void Exit(); /**< @brief Request the program terminate at the end of the current frame */
+		void SetExitCode(int exitCode) { m_ExitCode = exitCode; } /**< @brief Set the value returned from main once the app shuts down (e.g. to fail an automated run) */
+		int GetExitCode() const { return m_ExitCode; } /**< @brief The value to be returned from main, EXIT_SUCCESS unless set otherwise */
+
+		float GetFixedTimestep() const { return m_Specification.FixedTimestep; } /**< @brief Duration (in seconds) of each simulation step */
+
+		/**
+		 * @brief How far (as a fraction of a step) real time has run ahead of the latest simulation step.
+		 *
+		 * Rendering should interpolate between the previous and current simulation states by this amount,
+		 * so that motion stays smooth when the render and simulation rates differ.
+		 */
+		float GetFixedStepInterpolation() const { return m_FixedStepInterpolation; }
 
 	private:
 		ApplicationSpecification m_Specification;
 		static Application* s_Instance;
 
-		std::vector<std::function<void()>> m_MainThreadCommandQueue;
-		std::mutex m_MainThreadCommandQueueMutex;
+		MainThreadQueue m_MainThreadQueue;
 
+		EventQueue m_EventQueue; // declared before the window, so it outlives any events raised during its destruction
 		Scope<Window> m_Window;
 
 		LayerStack m_LayerStack;
@@ -142,10 +201,17 @@ namespace Zahra
 
 		bool m_Running = true;
 		bool m_Minimised = false;
+		int m_ExitCode = 0;
 
 		float m_PreviousFrameStartTime = .0f;
+		uint64_t m_FrameCount = 0;
+		float m_FixedStepAccumulator = .0f;
+		float m_FixedStepInterpolation = .0f;
 
 		void FlushCommandQueue();
+		void QueueEvent(Event& e);
+		void FixedUpdate(float dt);
+		void EndFrame(float frameStartTime);
 
 		bool OnWindowClosed(WindowClosedEvent& e);
 		bool OnWindowResized(WindowResizedEvent& e);
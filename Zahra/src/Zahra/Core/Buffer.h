@@ -2,11 +2,74 @@
 
 #include "Zahra/Core/Assert.h"
 #include "Zahra/Core/Memory.h"
+#include "Zahra/Core/Ref.h"
 #include "Zahra/Core/Types.h"
 
 namespace Zahra
 {
-	
+	/**
+	 * @brief A non-owning, read-only window onto a range of bytes. Cheap to copy and slice.
+	 */
+	struct BufferView
+	{
+		const void* Data = nullptr;
+		uint64_t Size = 0;
+
+		BufferView() = default;
+
+		BufferView(const void* data, uint64_t size)
+			: Data(data), Size(size)
+		{}
+
+		/**
+		 * @brief A view onto a sub-range of this one (no bytes are copied).
+		 *
+		 * @param offset Start of the slice, in bytes from the start of this view.
+		 * @param size Length of the slice, or everything after offset if omitted.
+		 */
+		BufferView Slice(uint64_t offset, uint64_t size = UINT64_MAX) const
+		{
+			Z_CORE_ASSERT(offset <= Size, "Buffer overflow");
+
+			if (size == UINT64_MAX)
+				size = Size - offset;
+
+			Z_CORE_ASSERT(offset + size <= Size, "Buffer overflow");
+
+			return BufferView((const byte*)Data + offset, size);
+		}
+
+		template <typename T>
+		const T& ReadAs(uint64_t offset = 0) const
+		{
+			Z_CORE_ASSERT(offset + sizeof(T) <= Size, "Buffer overflow");
+
+			return *(const T*)((const byte*)Data + offset);
+		}
+
+		operator bool() const
+		{
+			return Data != nullptr;
+		}
+
+		byte operator[](uint64_t index) const
+		{
+			return ((const byte*)Data)[index];
+		}
+
+		template <typename T>
+		const T* GetData() const
+		{
+			return (const T*)Data;
+		}
+
+		uint64_t GetSize() const
+		{
+			return Size;
+		}
+
+	};
+
 	struct Buffer
 	{
 		void* Data = nullptr;
@@ -70,6 +133,7 @@ namespace Zahra
 			return *(T*)((byte*)Data + offset);
 		}
 
+		// returns a new heap copy, owned by the caller (use View to read without copying)
 		byte* ReadBytes(uint64_t size, uint64_t offset = 0) const
 		{
 			Z_CORE_ASSERT(offset + size <= Size, "Buffer overflow");
@@ -87,6 +151,16 @@ namespace Zahra
 			memcpy((byte*)Data + offset, data, size);
 		}
 
+		BufferView View(uint64_t offset = 0, uint64_t size = UINT64_MAX) const
+		{
+			return BufferView(Data, Size).Slice(offset, size);
+		}
+
+		operator BufferView() const
+		{
+			return BufferView(Data, Size);
+		}
+
 		operator bool() const
 		{
 			return Data != nullptr;
@@ -115,4 +189,183 @@ namespace Zahra
 
 	};
 
+	/**
+	 * @brief Heap storage behind a SharedBuffer. Frees its bytes with the deleter it was given.
+	 */
+	class SharedBufferStorage : public RefCounted
+	{
+	public:
+		using Deleter = void(*)(void*);
+
+		SharedBufferStorage(void* data, uint64_t size, Deleter deleter)
+			: m_Data((byte*)data), m_Size(size), m_Deleter(deleter)
+		{}
+
+		~SharedBufferStorage()
+		{
+			if (m_Data && m_Deleter)
+				m_Deleter(m_Data);
+		}
+
+		byte* GetData() const { return m_Data; }
+		uint64_t GetSize() const { return m_Size; }
+
+		static void DeleteByteArray(void* data) { delete[] (byte*)data; }
+
+	private:
+		byte* m_Data;
+		uint64_t m_Size;
+		Deleter m_Deleter;
+	};
+
+	/**
+	 * @brief An owning, reference-counted, copy-on-write byte buffer.
+	 *
+	 * Copies and slices share the same storage, so a buffer can be handed from file IO to a decoder to the
+	 * renderer without its bytes being duplicated, and the storage is freed when the last reference goes.
+	 * Read access is through const methods; GetMutableData (and anything else that writes) first detaches
+	 * this buffer onto its own copy of the bytes if the storage is shared.
+	 */
+	class SharedBuffer
+	{
+	public:
+		SharedBuffer() = default;
+
+		/**
+		 * @brief Create a buffer owning size bytes of uninitialised storage.
+		 */
+		static SharedBuffer Allocate(uint64_t size)
+		{
+			if (size == 0)
+				return SharedBuffer();
+
+			return Adopt(znew byte[size], size, SharedBufferStorage::DeleteByteArray);
+		}
+
+		/**
+		 * @brief Create a buffer owning a copy of the given bytes.
+		 */
+		static SharedBuffer Copy(BufferView data)
+		{
+			SharedBuffer buffer = Allocate(data.Size);
+			if (buffer)
+				memcpy(buffer.m_Storage->GetData(), data.Data, data.Size);
+
+			return buffer;
+		}
+
+		/**
+		 * @brief Take ownership of existing heap memory, without copying it.
+		 *
+		 * @param data Memory to be owned. Must not be freed elsewhere.
+		 * @param size Length of data, in bytes.
+		 * @param deleter Called to free data once the last reference is released (e.g. stbi_image_free).
+		 */
+		static SharedBuffer Adopt(void* data, uint64_t size, SharedBufferStorage::Deleter deleter = SharedBufferStorage::DeleteByteArray)
+		{
+			SharedBuffer buffer;
+
+			if (!data)
+				return buffer;
+
+			buffer.m_Storage = Ref<SharedBufferStorage>::Create(data, size, deleter);
+			buffer.m_Size = size;
+
+			return buffer;
+		}
+
+		void Release()
+		{
+			m_Storage = nullptr;
+			m_Offset = 0;
+			m_Size = 0;
+		}
+
+		/**
+		 * @brief A buffer sharing a sub-range of this one's storage (no bytes are copied).
+		 */
+		SharedBuffer Slice(uint64_t offset, uint64_t size = UINT64_MAX) const
+		{
+			BufferView slice = View().Slice(offset, size);
+
+			SharedBuffer buffer = *this;
+			buffer.m_Offset += offset;
+			buffer.m_Size = slice.Size;
+
+			return buffer;
+		}
+
+		BufferView View() const
+		{
+			return BufferView(GetData<void>(), m_Size);
+		}
+
+		operator BufferView() const
+		{
+			return View();
+		}
+
+		/**
+		 * @brief Writable access to this buffer's bytes, copying them first if the storage is shared.
+		 */
+		byte* GetMutableData()
+		{
+			if (!m_Storage)
+				return nullptr;
+
+			if (m_Storage->GetRefCount() > 1)
+				*this = Copy(View());
+
+			return m_Storage->GetData() + m_Offset;
+		}
+
+		void Write(const void* data, uint64_t size, uint64_t offset = 0)
+		{
+			Z_CORE_ASSERT(offset + size <= m_Size, "Buffer overflow");
+
+			memcpy(GetMutableData() + offset, data, size);
+		}
+
+		void ZeroInitialise()
+		{
+			if (m_Storage)
+				memset(GetMutableData(), 0, m_Size);
+		}
+
+		template <typename T>
+		const T& ReadAs(uint64_t offset = 0) const
+		{
+			return View().ReadAs<T>(offset);
+		}
+
+		template <typename T>
+		const T* GetData() const
+		{
+			return m_Storage ? (const T*)(m_Storage->GetData() + m_Offset) : nullptr;
+		}
+
+		uint64_t GetSize() const
+		{
+			return m_Size;
+		}
+
+		/**
+		 * @brief Is this the only reference to its storage (i.e. can it be written without copying)?
+		 */
+		bool IsUnique() const
+		{
+			return m_Storage && m_Storage->GetRefCount() == 1;
+		}
+
+		operator bool() const
+		{
+			return (bool)m_Storage;
+		}
+
+	private:
+		Ref<SharedBufferStorage> m_Storage;
+		uint64_t m_Offset = 0;
+		uint64_t m_Size = 0;
+	};
+
 }
@@ -25,9 +25,10 @@ int main(int argc, char** argv)
 		return EXIT_FAILURE;
 	}
 
+	int exitCode = app->GetExitCode();
 	delete app;
 
-	return EXIT_SUCCESS;
+	return exitCode;
 }
 
 #endif
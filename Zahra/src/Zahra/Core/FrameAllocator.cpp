@@ -0,0 +1,150 @@
+#include "zpch.h"
+#include "FrameAllocator.h"
+
+#include "Zahra/Core/Memory.h"
+#include "Zahra/Core/Mutex.h"
+
+#include <atomic>
+
+namespace Zahra
+{
+	struct FrameArena
+	{
+		byte* Data = nullptr;
+		std::atomic<uint64_t> Offset = 0;
+
+		// spill-over for when the arena is exhausted (rare, so guarded by a mutex)
+		std::vector<byte*> Overflow;
+		uint64_t OverflowBytes = 0;
+		Mutex OverflowMutex{ "FrameAllocator::Overflow" };
+	};
+
+	struct FrameAllocatorData
+	{
+		std::vector<Scope<FrameArena>> Arenas;
+		uint64_t ArenaSize = 0;
+
+		std::atomic<FrameArena*> CurrentArena = nullptr;
+
+		uint64_t HighWaterMark = 0;
+		std::atomic<uint32_t> OverflowCount = 0;
+	};
+
+	static FrameAllocatorData s_FrameAllocatorData;
+
+	static void ReleaseOverflow(FrameArena& arena)
+	{
+		for (byte* allocation : arena.Overflow)
+			zdelete[] allocation;
+
+		arena.Overflow.clear();
+		arena.OverflowBytes = 0;
+	}
+
+	void FrameAllocator::Init(uint32_t framesInFlight, uint64_t arenaSize)
+	{
+		Z_CORE_ASSERT(s_FrameAllocatorData.Arenas.empty(), "FrameAllocator already initialised");
+		Z_CORE_ASSERT(framesInFlight > 0);
+
+		s_FrameAllocatorData.ArenaSize = arenaSize;
+
+		for (uint32_t frame = 0; frame < framesInFlight; frame++)
+		{
+			auto& arena = s_FrameAllocatorData.Arenas.emplace_back(CreateScope<FrameArena>());
+			arena->Data = znew byte[arenaSize];
+		}
+
+		s_FrameAllocatorData.CurrentArena = s_FrameAllocatorData.Arenas[0].get();
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		s_FrameAllocatorData.CurrentArena = nullptr;
+
+		for (auto& arena : s_FrameAllocatorData.Arenas)
+		{
+			ReleaseOverflow(*arena);
+			zdelete[] arena->Data;
+		}
+
+		s_FrameAllocatorData.Arenas.clear();
+	}
+
+	void FrameAllocator::BeginFrame(uint32_t frameIndex)
+	{
+		Z_CORE_ASSERT(frameIndex < s_FrameAllocatorData.Arenas.size());
+
+		FrameArena& arena = *s_FrameAllocatorData.Arenas[frameIndex];
+
+		uint64_t usage = std::min(arena.Offset.load(), s_FrameAllocatorData.ArenaSize) + arena.OverflowBytes;
+		s_FrameAllocatorData.HighWaterMark = std::max(s_FrameAllocatorData.HighWaterMark, usage);
+
+		ReleaseOverflow(arena);
+		arena.Offset = 0;
+
+		s_FrameAllocatorData.CurrentArena = &arena;
+	}
+
+	void* FrameAllocator::Allocate(uint64_t size, uint64_t alignment)
+	{
+		Z_CORE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		FrameArena* arena = s_FrameAllocatorData.CurrentArena.load(std::memory_order_acquire);
+
+		if (arena)
+		{
+			uint64_t base = (uint64_t)arena->Data;
+			uint64_t offset = arena->Offset.load(std::memory_order_relaxed);
+			uint64_t alignedOffset;
+
+			do
+			{
+				alignedOffset = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+
+				if (alignedOffset + size > s_FrameAllocatorData.ArenaSize)
+					break;
+			}
+			while (!arena->Offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+			if (alignedOffset + size <= s_FrameAllocatorData.ArenaSize)
+				return arena->Data + alignedOffset;
+		}
+
+		// arena exhausted (or not yet initialised), so fall back to the heap until the arena is next reset
+		s_FrameAllocatorData.OverflowCount++;
+
+		byte* allocation = znew byte[size + alignment];
+		byte* aligned = (byte*)(((uint64_t)allocation + alignment - 1) & ~(alignment - 1));
+
+		if (arena)
+		{
+			ScopedLock lock(arena->OverflowMutex);
+			arena->Overflow.push_back(allocation);
+			arena->OverflowBytes += size;
+		}
+		else
+		{
+			Z_CORE_WARN("FrameAllocator used before initialisation, leaking {0} bytes", size);
+		}
+
+		return aligned;
+	}
+
+	FrameAllocatorStats FrameAllocator::GetStats()
+	{
+		FrameAllocatorStats stats;
+		stats.Capacity = s_FrameAllocatorData.ArenaSize;
+		stats.OverflowCount = s_FrameAllocatorData.OverflowCount.load();
+
+		if (FrameArena* arena = s_FrameAllocatorData.CurrentArena.load())
+		{
+			stats.OverflowBytes = arena->OverflowBytes;
+			stats.CurrentUsage = std::min(arena->Offset.load(), s_FrameAllocatorData.ArenaSize) + arena->OverflowBytes;
+		}
+
+		stats.HighWaterMark = std::max(s_FrameAllocatorData.HighWaterMark, stats.CurrentUsage);
+
+		return stats;
+	}
+
+}
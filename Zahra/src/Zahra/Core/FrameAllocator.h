@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Zahra/Core/Types.h"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief Struct containing a summary of FrameAllocator usage.
+	 */
+	struct FrameAllocatorStats
+	{
+		uint64_t Capacity = 0; /**< @brief Size of each per-frame arena, in bytes. */
+		uint64_t CurrentUsage = 0; /**< @brief Bytes handed out so far from the current frame's arena (including overflow). */
+		uint64_t HighWaterMark = 0; /**< @brief Largest number of bytes any single frame has requested since initialisation. */
+		uint64_t OverflowBytes = 0; /**< @brief Bytes the current frame has had to take from the general heap, because its arena was full. */
+		uint32_t OverflowCount = 0; /**< @brief Total number of allocations that have overflowed onto the general heap since initialisation. */
+	};
+
+	/**
+	 * @brief A linear (bump) allocator for transient data that lives no longer than a single frame.
+	 *
+	 * One arena is kept per frame in flight. Memory handed out during a frame remains valid until the same
+	 * frame index comes around again, at which point the whole arena is reset in one go. The arenas are plain
+	 * host memory, reset before that frame's fence is waited on, so they are for CPU-side scratch data only:
+	 * never hand the GPU (or anything it reads asynchronously) a pointer into them.
+	 * Nothing is destructed on reset, so only trivially destructible data should be placed here.
+	 *
+	 * Allocation is lock-free. If an arena is exhausted, requests spill onto the general heap until the arena
+	 * is next reset, and the overflow is reported through GetStats so the arena size can be tuned.
+	 */
+	class FrameAllocator
+	{
+	public:
+		/**
+		 * @brief Allocates the per-frame arenas. Called by Application once the Renderer is up.
+		 *
+		 * @param framesInFlight Number of arenas to cycle through (should match Renderer::GetFramesInFlight).
+		 * @param arenaSize Size of each arena, in bytes.
+		 */
+		static void Init(uint32_t framesInFlight, uint64_t arenaSize);
+		static void Shutdown();
+
+		/**
+		 * @brief Resets the arena belonging to the given frame index, invalidating everything allocated from it.
+		 *
+		 * @param frameIndex Typically Renderer::GetCurrentFrameIndex(), called at the top of the frame.
+		 */
+		static void BeginFrame(uint32_t frameIndex);
+
+		/**
+		 * @brief Allocate transient memory from the current frame's arena.
+		 *
+		 * @param size Requested allocation size, in bytes.
+		 * @param alignment Requested alignment (must be a power of two).
+		 * @return Pointer to memory that stays valid until this frame's arena is next reset.
+		 */
+		static void* Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+		/**
+		 * @brief Construct an object in the current frame's arena. It will never be destructed.
+		 */
+		template<typename T, typename... Args>
+		static T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Frame allocations are never destructed");
+
+			return new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		static FrameAllocatorStats GetStats();
+	};
+
+	/**
+	 * @brief STL-compatible allocator adaptor drawing from the FrameAllocator. Deallocation is a no-op.
+	 */
+	template <class T>
+	struct FrameStdAllocator
+	{
+		typedef T value_type;
+
+		FrameStdAllocator() = default;
+		template <class U>
+		constexpr FrameStdAllocator(const FrameStdAllocator <U>&) noexcept {}
+
+		T* allocate(std::size_t n)
+		{
+			if (n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+				throw std::bad_array_new_length();
+
+			return static_cast<T*>(FrameAllocator::Allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept {}
+
+		template <class U>
+		bool operator==(const FrameStdAllocator<U>&) const noexcept { return true; }
+
+		template <class U>
+		bool operator!=(const FrameStdAllocator<U>&) const noexcept { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStdAllocator<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStdAllocator<char>>;
+
+}
@@ -0,0 +1,375 @@
+#include "zpch.h"
+#include "JobSystem.h"
+
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Core/PoolAllocator.h"
+#include "Zahra/Core/Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Zahra
+{
+	class Job : public RefCounted
+	{
+	public:
+		Z_POOL_ALLOCATED()
+
+		std::function<void()> Task;
+		const char* Name = "Job";
+
+		// dependencies yet to finish, plus one held by Schedule while it registers them
+		std::atomic<uint32_t> PendingDependencies = 1;
+		std::atomic<bool> Finished = false;
+
+		Mutex ContinuationMutex{ "JobSystem::Continuations" };
+		std::vector<Ref<Job>> Continuations;
+	};
+
+	struct JobQueue
+	{
+		Mutex QueueMutex{ "JobSystem::Queue" };
+		std::deque<Ref<Job>> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<Scope<Thread>> Workers;
+		std::vector<Scope<JobQueue>> WorkerQueues;
+		std::atomic<uint32_t> WorkerCount = 0; // only non-zero while every worker is up
+		JobQueue SharedQueue;
+
+		std::atomic<bool> Running = false;
+
+		// idle workers sleep until there are jobs ready to run
+		std::atomic<uint64_t> PendingJobs = 0; // queued, not yet popped
+		std::atomic<uint64_t> ActiveJobs = 0; // queued or still executing, which Shutdown waits to reach zero
+		std::atomic<uint32_t> SleepingWorkers = 0;
+		std::mutex SleepMutex;
+		std::condition_variable WakeCondition;
+
+		std::atomic<uint64_t> JobsExecuted = 0;
+		std::atomic<uint64_t> JobsStolen = 0;
+	};
+
+	static JobSystemData s_JobSystemData;
+
+	// index of the calling thread's own queue, or -1 if it isn't a worker
+	static thread_local int32_t t_WorkerIndex = -1;
+
+	namespace JobSystemUtils
+	{
+		static void Enqueue(Ref<Job> job);
+
+		static void Execute(Ref<Job>& job)
+		{
+			{
+				Z_PROFILE_SCOPE(job->Name);
+				job->Task();
+			}
+
+			// release anything the task captured as soon as possible
+			job->Task = nullptr;
+
+			s_JobSystemData.JobsExecuted.fetch_add(1, std::memory_order_relaxed);
+
+			std::vector<Ref<Job>> continuations;
+			{
+				ScopedLock lock(job->ContinuationMutex);
+				job->Finished.store(true, std::memory_order_release);
+				continuations.swap(job->Continuations);
+			}
+
+			for (auto& continuation : continuations)
+			{
+				if (continuation->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					Enqueue(continuation);
+			}
+		}
+
+		static void Enqueue(Ref<Job> job)
+		{
+			// with no workers (single core, or after shutdown) everything runs synchronously
+			if (s_JobSystemData.WorkerCount.load(std::memory_order_acquire) == 0)
+			{
+				Execute(job);
+				return;
+			}
+
+			// counted before the job is published, so that popping it can never take either count below zero
+			s_JobSystemData.ActiveJobs.fetch_add(1);
+			s_JobSystemData.PendingJobs.fetch_add(1);
+
+			JobQueue& queue = t_WorkerIndex >= 0 ? *s_JobSystemData.WorkerQueues[t_WorkerIndex] : s_JobSystemData.SharedQueue;
+			{
+				Z_PROFILE_SCOPE("JobSystem::Enqueue");
+				ScopedLock lock(queue.QueueMutex);
+				queue.Jobs.push_back(std::move(job));
+			}
+
+			if (s_JobSystemData.SleepingWorkers.load() > 0)
+			{
+				std::scoped_lock<std::mutex> lock(s_JobSystemData.SleepMutex);
+				s_JobSystemData.WakeCondition.notify_one();
+			}
+		}
+
+		static bool PopBack(JobQueue& queue, Ref<Job>& job)
+		{
+			ScopedLock lock(queue.QueueMutex);
+			if (queue.Jobs.empty()) return false;
+
+			job = std::move(queue.Jobs.back());
+			queue.Jobs.pop_back();
+			return true;
+		}
+
+		static bool PopFront(JobQueue& queue, Ref<Job>& job)
+		{
+			ScopedLock lock(queue.QueueMutex);
+			if (queue.Jobs.empty()) return false;
+
+			job = std::move(queue.Jobs.front());
+			queue.Jobs.pop_front();
+			return true;
+		}
+
+		static bool TryPop(Ref<Job>& job)
+		{
+			int32_t self = t_WorkerIndex;
+			size_t workerCount = s_JobSystemData.WorkerQueues.size();
+
+			// newest of our own jobs first, then the oldest externally submitted job
+			bool found = (self >= 0 && PopBack(*s_JobSystemData.WorkerQueues[self], job))
+				|| PopFront(s_JobSystemData.SharedQueue, job);
+
+			if (!found)
+			{
+				Z_PROFILE_SCOPE("JobSystem::Steal");
+
+				for (size_t i = 1; i <= workerCount && !found; i++)
+				{
+					size_t victim = (self + i) % workerCount;
+					if ((int32_t)victim == self) continue;
+
+					found = PopFront(*s_JobSystemData.WorkerQueues[victim], job);
+				}
+
+				if (found)
+					s_JobSystemData.JobsStolen.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			if (found)
+				s_JobSystemData.PendingJobs.fetch_sub(1);
+
+			return found;
+		}
+
+		// pop a queued job and run it, returning false if there was nothing to run
+		static bool RunOne()
+		{
+			Ref<Job> job;
+			if (!TryPop(job))
+				return false;
+
+			Execute(job);
+
+			// only now that any continuations it released have been queued (and counted) does this job stop being active
+			s_JobSystemData.ActiveJobs.fetch_sub(1);
+			return true;
+		}
+
+		static void WorkerLoop(int32_t index)
+		{
+			t_WorkerIndex = index;
+
+			while (s_JobSystemData.Running)
+			{
+				if (RunOne())
+					continue;
+
+				std::unique_lock<std::mutex> lock(s_JobSystemData.SleepMutex);
+				s_JobSystemData.SleepingWorkers.fetch_add(1);
+				s_JobSystemData.WakeCondition.wait(lock, []() { return s_JobSystemData.PendingJobs.load() > 0 || !s_JobSystemData.Running; });
+				s_JobSystemData.SleepingWorkers.fetch_sub(1);
+			}
+
+			t_WorkerIndex = -1;
+		}
+	}
+
+	JobHandle::JobHandle() = default;
+	JobHandle::JobHandle(const JobHandle& other) = default;
+	JobHandle& JobHandle::operator=(const JobHandle& other) = default;
+	JobHandle::~JobHandle() = default;
+
+	JobHandle::JobHandle(Ref<Job> job)
+		: m_Job(job) {}
+
+	bool JobHandle::IsFinished() const
+	{
+		return !m_Job || m_Job->Finished.load(std::memory_order_acquire);
+	}
+
+	void JobHandle::Wait() const
+	{
+		JobSystem::Wait(*this);
+	}
+
+	JobHandle JobHandle::Then(const std::function<void()>& task, const char* name) const
+	{
+		return JobSystem::Schedule(task, { *this }, name);
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		Z_CORE_ASSERT(!s_JobSystemData.Running, "JobSystem already initialised");
+
+		if (workerCount == 0)
+			workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		s_JobSystemData.Running = true;
+
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_JobSystemData.WorkerQueues.emplace_back(CreateScope<JobQueue>());
+
+		for (uint32_t i = 0; i < workerCount; i++)
+		{
+			auto& worker = s_JobSystemData.Workers.emplace_back(CreateScope<Thread>("Job Worker " + std::to_string(i)));
+			worker->Dispatch(JobSystemUtils::WorkerLoop, (int32_t)i);
+		}
+
+		s_JobSystemData.WorkerCount.store(workerCount, std::memory_order_release);
+
+		Z_CORE_INFO("JobSystem started {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_JobSystemData.Running) return;
+
+		// help drain the queues until every job has finished running, so that nothing already scheduled (including
+		// continuations released by jobs still executing on the workers) is lost
+		while (s_JobSystemData.ActiveJobs.load() > 0)
+		{
+			if (!JobSystemUtils::RunOne())
+				std::this_thread::yield();
+		}
+
+		{
+			std::scoped_lock<std::mutex> lock(s_JobSystemData.SleepMutex);
+			s_JobSystemData.Running = false;
+			s_JobSystemData.WakeCondition.notify_all();
+		}
+
+		for (auto& worker : s_JobSystemData.Workers)
+			worker->Join();
+
+		s_JobSystemData.WorkerCount = 0;
+
+		s_JobSystemData.Workers.clear();
+		s_JobSystemData.WorkerQueues.clear();
+	}
+
+	JobHandle JobSystem::Schedule(const std::function<void()>& task, const char* name)
+	{
+		return Schedule(task, {}, name);
+	}
+
+	JobHandle JobSystem::Schedule(const std::function<void()>& task, const std::vector<JobHandle>& dependencies, const char* name)
+	{
+		Ref<Job> job = Ref<Job>::Create();
+		job->Task = task;
+		job->Name = name;
+
+		for (auto& dependency : dependencies)
+		{
+			Ref<Job> dependencyJob = dependency.m_Job;
+			if (!dependencyJob) continue;
+
+			ScopedLock lock(dependencyJob->ContinuationMutex);
+			if (dependencyJob->Finished.load(std::memory_order_acquire)) continue;
+
+			job->PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+			dependencyJob->Continuations.push_back(job);
+		}
+
+		// release Schedule's own hold, queueing the job if its dependencies have all finished already
+		if (job->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			JobSystemUtils::Enqueue(job);
+
+		return JobHandle(job);
+	}
+
+	JobHandle JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)>& task, const char* name)
+	{
+		if (count == 0) return {};
+
+		if (batchSize == 0)
+		{
+			uint32_t threadCount = GetWorkerCount() + 1;
+			batchSize = std::max(count / (4 * threadCount), 1u);
+		}
+
+		if (batchSize >= count)
+			return Schedule([task, count]() { task(0, count); }, name);
+
+		std::vector<JobHandle> batches;
+		batches.reserve((count + batchSize - 1) / batchSize);
+
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			uint32_t end = std::min(begin + batchSize, count);
+			batches.push_back(Schedule([task, begin, end]() { task(begin, end); }, name));
+		}
+
+		return Schedule([]() {}, batches, name);
+	}
+
+	void JobSystem::Wait(const JobHandle& handle)
+	{
+		Z_PROFILE_SCOPE("JobSystem::Wait");
+
+		while (!handle.IsFinished())
+		{
+			if (!JobSystemUtils::RunOne())
+				std::this_thread::yield();
+		}
+	}
+
+	void JobSystem::WaitAll(const std::vector<JobHandle>& handles)
+	{
+		for (auto& handle : handles)
+			Wait(handle);
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+		return JobSystemUtils::RunOne();
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return s_JobSystemData.WorkerCount.load(std::memory_order_relaxed);
+	}
+
+	bool JobSystem::IsWorkerThread()
+	{
+		return t_WorkerIndex >= 0;
+	}
+
+	JobSystemStats JobSystem::GetStats()
+	{
+		JobSystemStats stats;
+		stats.WorkerCount = GetWorkerCount();
+		stats.JobsExecuted = s_JobSystemData.JobsExecuted.load(std::memory_order_relaxed);
+		stats.JobsStolen = s_JobSystemData.JobsStolen.load(std::memory_order_relaxed);
+		stats.JobsPending = s_JobSystemData.PendingJobs.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Zahra/Core/Ref.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Zahra
+{
+	class Job;
+
+	/**
+	 * @brief A reference to a job submitted to the JobSystem, used to wait on it or chain further work after it.
+	 *
+	 * Handles are cheap to copy. A default-constructed handle refers to no job, and counts as already finished.
+	 */
+	class JobHandle
+	{
+	public:
+		// defined alongside Job, which is only complete in JobSystem.cpp
+		JobHandle();
+		JobHandle(const JobHandle& other);
+		JobHandle& operator=(const JobHandle& other);
+		~JobHandle();
+
+		bool IsFinished() const;
+
+		/**
+		 * @brief Block until the job has finished, running other jobs on this thread in the meantime.
+		 */
+		void Wait() const;
+
+		/**
+		 * @brief Schedule a continuation, to be run once this job has finished.
+		 */
+		JobHandle Then(const std::function<void()>& task, const char* name = "Job") const;
+
+		operator bool() const { return (bool)m_Job; }
+
+	private:
+		JobHandle(Ref<Job> job);
+
+		Ref<Job> m_Job;
+
+		friend class JobSystem;
+	};
+
+	/**
+	 * @brief Struct containing a summary of JobSystem activity.
+	 */
+	struct JobSystemStats
+	{
+		uint32_t WorkerCount = 0; /**< @brief Number of worker threads (not including threads that help while waiting). */
+		uint64_t JobsExecuted = 0; /**< @brief Total number of jobs run since initialisation. */
+		uint64_t JobsStolen = 0; /**< @brief Number of those jobs taken from another worker's queue. */
+		uint64_t JobsPending = 0; /**< @brief Number of jobs queued and ready to run, but not yet picked up. */
+	};
+
+	/**
+	 * @brief A work-stealing task scheduler, with one worker thread per hardware thread (less one for the main thread).
+	 *
+	 * Each worker owns a queue: jobs it schedules are pushed there and popped in LIFO order (so related work stays
+	 * cache-hot), while idle workers steal the oldest jobs from the front of other workers' queues. Jobs scheduled
+	 * from any other thread go into a shared queue. Jobs may depend on other jobs, in which case they are only
+	 * queued once all their dependencies have finished.
+	 *
+	 * Threads that wait on a job help out by running queued jobs until it finishes, so it is safe to wait from
+	 * inside a job. Every job runs inside a Z_PROFILE_SCOPE carrying its name.
+	 */
+	class JobSystem
+	{
+	public:
+		/**
+		 * @brief Start the worker threads. Called by Application before any other subsystem.
+		 *
+		 * @param workerCount Number of worker threads, or 0 for one per hardware thread less one.
+		 */
+		static void Init(uint32_t workerCount = 0);
+
+		/**
+		 * @brief Finish all outstanding jobs, then join the worker threads.
+		 */
+		static void Shutdown();
+
+		/**
+		 * @brief Queue a job to be run on any thread.
+		 *
+		 * @param task The work to be done.
+		 * @param name Label for the job's profiling scope (must outlive the job, e.g. a string literal).
+		 */
+		static JobHandle Schedule(const std::function<void()>& task, const char* name = "Job");
+
+		/**
+		 * @brief Queue a job to be run on any thread, once all of the given jobs have finished.
+		 */
+		static JobHandle Schedule(const std::function<void()>& task, const std::vector<JobHandle>& dependencies, const char* name = "Job");
+
+		/**
+		 * @brief Split the index range [0, count) into batches, and process them in parallel.
+		 *
+		 * @param count Number of indices to process.
+		 * @param batchSize Number of indices handed to each job (0 picks a size giving each worker a few batches).
+		 * @param task Called with the begin and end (exclusive) indices of each batch.
+		 * @return A handle which finishes once every batch has.
+		 */
+		static JobHandle ParallelFor(uint32_t count, uint32_t batchSize, const std::function<void(uint32_t, uint32_t)>& task, const char* name = "ParallelFor");
+
+		static void Wait(const JobHandle& handle);
+		static void WaitAll(const std::vector<JobHandle>& handles);
+
+		/**
+		 * @brief Run one queued job on the calling thread, if there are any ready.
+		 *
+		 * @return False if there was nothing to run.
+		 */
+		static bool RunPendingJob();
+
+		static uint32_t GetWorkerCount();
+
+		/**
+		 * @brief Is the calling thread one of the JobSystem's workers?
+		 */
+		static bool IsWorkerThread();
+
+		static JobSystemStats GetStats();
+	};
+
+}
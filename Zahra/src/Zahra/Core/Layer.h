@@ -15,6 +15,7 @@ namespace Zahra
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 		virtual void OnUpdate(float dt) {}
+		virtual void OnFixedUpdate(float dt) {} // called zero or more times per frame, before OnUpdate, with Application's fixed timestep
 		virtual void OnImGuiRender() {}
 		virtual void OnEvent(Event& event) {}
 
@@ -0,0 +1,81 @@
+#include "zpch.h"
+#include "MainThreadQueue.h"
+
+#include <chrono>
+
+namespace Zahra
+{
+	MainThreadQueue::~MainThreadQueue()
+	{
+		// anything still queued is discarded unrun
+		Command* command = m_Head.exchange(nullptr, std::memory_order_acquire);
+		while (command)
+		{
+			Command* next = command->Next;
+			zdelete command;
+			command = next;
+		}
+
+		while (m_Pending)
+		{
+			Command* next = m_Pending->Next;
+			zdelete m_Pending;
+			m_Pending = next;
+		}
+	}
+
+	uint32_t MainThreadQueue::Flush(float budget)
+	{
+		Z_PROFILE_FUNCTION();
+
+		// take everything submitted so far, reversing the stack into submission order
+		Command* submitted = m_Head.exchange(nullptr, std::memory_order_acquire);
+		Command* oldest = nullptr;
+		Command* newest = submitted;
+		while (submitted)
+		{
+			Command* next = submitted->Next;
+			submitted->Next = oldest;
+			oldest = submitted;
+			submitted = next;
+		}
+
+		if (oldest)
+		{
+			if (m_PendingTail)
+				m_PendingTail->Next = oldest;
+			else
+				m_Pending = oldest;
+
+			m_PendingTail = newest;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(budget));
+
+		uint32_t commandsRun = 0;
+		while (m_Pending)
+		{
+			// unlink before running, so the list stays consistent if the command re-enters Flush
+			Command* command = m_Pending;
+			m_Pending = command->Next;
+			if (!m_Pending)
+				m_PendingTail = nullptr;
+
+			command->Invoke();
+			zdelete command;
+			commandsRun++;
+
+			if (budget > .0f && std::chrono::steady_clock::now() >= deadline)
+				break;
+		}
+
+		return commandsRun;
+	}
+
+	bool MainThreadQueue::IsEmpty() const
+	{
+		return !m_Pending && !m_Head.load(std::memory_order_relaxed);
+	}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Zahra/Core/Memory.h"
+#include "Zahra/Core/PoolAllocator.h"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Zahra
+{
+	/**
+	 * @brief A lock-free multi-producer, single-consumer queue of commands, for handing work from any thread
+	 * to the main thread.
+	 *
+	 * Producers push onto an intrusive stack with a single compare-and-swap, so submitting never blocks on the
+	 * consumer, however long a flush takes. Flush swaps out the whole stack in one exchange and runs its contents
+	 * in submission order, so commands submitted while a flush is running (including by the commands themselves)
+	 * are left for the next flush.
+	 *
+	 * Each command's callable is stored inline in a pool-allocated node, rather than in a std::function with a
+	 * heap allocation of its own.
+	 */
+	class MainThreadQueue
+	{
+	public:
+		MainThreadQueue() = default;
+		~MainThreadQueue();
+
+		MainThreadQueue(const MainThreadQueue&) = delete;
+		MainThreadQueue& operator=(const MainThreadQueue&) = delete;
+
+		/**
+		 * @brief Queue a callable (taking no arguments) to run at the next flush. Safe to call from any thread.
+		 */
+		template<typename F>
+		void Submit(F&& command)
+		{
+			Command* node = znew CommandImpl<std::decay_t<F>>(std::forward<F>(command));
+
+			Command* head = m_Head.load(std::memory_order_relaxed);
+			do
+			{
+				node->Next = head;
+			} while (!m_Head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief Run queued commands, oldest first. Must only be called from the consuming thread.
+		 *
+		 * @param budget Time limit (in seconds), beyond which any remaining commands are left for the next flush.
+		 * At least one command always runs, so the queue can't stall. Zero or less runs everything.
+		 * @return The number of commands run.
+		 */
+		uint32_t Flush(float budget = .0f);
+
+		/**
+		 * @brief Are there any commands waiting, either newly submitted or left over from a budgeted flush?
+		 */
+		bool IsEmpty() const;
+
+	private:
+		struct Command
+		{
+			Z_POOL_ALLOCATED()
+
+			Command* Next = nullptr;
+
+			virtual ~Command() = default;
+			virtual void Invoke() = 0;
+		};
+
+		template<typename F>
+		struct CommandImpl : public Command
+		{
+			F Func;
+
+			template<typename G>
+			CommandImpl(G&& func)
+				: Func(std::forward<G>(func)) {}
+
+			void Invoke() override { Func(); }
+		};
+
+		std::atomic<Command*> m_Head = nullptr; // newest first
+
+		// consumer-owned, oldest first: commands taken from the stack that a budgeted flush didn't get to
+		Command* m_Pending = nullptr;
+		Command* m_PendingTail = nullptr;
+	};
+
+}
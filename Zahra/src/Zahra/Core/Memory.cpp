@@ -1,28 +1,27 @@
 #include "zpch.h"
 #include "Memory.h"
 
+#include "Zahra/Core/Types.h"
+#include "Zahra/Debug/HeapProfiler.h"
+
 namespace Zahra
 {
-	static AllocationStats s_GlobalAllocationStats;
-
-	static bool s_Initialising = false;
-
-	const AllocationStats& Memory::GetAllocationStats()
-	{
-		return s_GlobalAllocationStats;
-	}
+	AllocatorData Allocator::s_Data;
 
-	void Allocator::Init()
+	AllocationStats Memory::GetAllocationStats()
 	{
-		if (s_Data) return;
+		AllocationStats stats;
 
-		s_Initialising = true;
+		for (const auto& counter : Allocator::s_Data.m_GlobalCounters)
 		{
-			AllocatorData* data = (AllocatorData*)AllocateRaw(sizeof(AllocatorData));
-			new(data) AllocatorData();
-			s_Data = data;
+			stats.TotalAllocated += counter.TotalAllocated.load(std::memory_order_relaxed);
+			stats.TotalFreed += counter.TotalFreed.load(std::memory_order_relaxed);
+			stats.AllocationCount += counter.AllocationCount.load(std::memory_order_relaxed);
 		}
-		s_Initialising = false;
+
+		stats.InvalidFreeCount = Allocator::s_Data.m_InvalidFreeCount.load(std::memory_order_relaxed);
+
+		return stats;
 	}
 
 	void* Allocator::AllocateRaw(size_t size)
@@ -32,96 +31,188 @@ namespace Zahra
 
 	void* Allocator::Allocate(size_t size)
 	{
-		// avoids 'new' making calls to s_Data before it's been initialised
-		if (s_Initialising) return AllocateRaw(size);
+		return Allocate(size, nullptr);
+	}
+
+	void* Allocator::Allocate(size_t size, const char* category)
+	{
+		void* block = malloc(sizeof(AllocationHeader) + size);
+		if (!block) return nullptr;
+
+		return TrackAllocation(block, 0, size, category);
+	}
+
+	void* Allocator::Allocate(size_t size, const char* file, int line)
+	{
+		return Allocate(size, file);
+	}
 
-		if (!s_Data) Init();
+	void* Allocator::AllocateAligned(size_t size, size_t alignment, const char* category)
+	{
+		if (alignment <= alignof(AllocationHeader))
+			return Allocate(size, category);
 
-		void* location = malloc(size);
+		void* block = malloc(sizeof(AllocationHeader) + alignment + size);
+		if (!block) return nullptr;
 
+		// place the header so that the user pointer immediately following it lands on the requested alignment
+		uintptr_t user = ((uintptr_t)block + sizeof(AllocationHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		size_t offset = user - sizeof(AllocationHeader) - (uintptr_t)block;
+
+		return TrackAllocation(block, offset, size, category);
+	}
+
+	void* Allocator::TrackAllocation(void* block, size_t offset, size_t size, const char* category)
+	{
+		AllocationHeader* header = (AllocationHeader*)((byte*)block + offset);
+		header->Size = size;
+		header->Magic = AllocationHeader::MagicValue;
+		header->Offset = (uint32_t)offset;
+		header->Slot = nullptr;
+		header->SampleWeight = 0;
+
+		uint32_t interval = s_Data.m_SamplingInterval.load(std::memory_order_relaxed);
+
+		if (interval > 1)
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
+			thread_local uint32_t countdown = 0;
 
-			Allocation& alloc = s_Data->m_AllocationMap[location];
-			alloc.Location = location;
-			alloc.Size = size;
+			if (countdown == 0 || countdown > interval)
+				countdown = interval;
 
-			s_GlobalAllocationStats.TotalAllocated += size;
+			if (--countdown != 0)
+				return header + 1;
 		}
 
-		return location;
+		header->SampleWeight = interval > 1 ? interval : 1;
+		header->Slot = GetCategorySlot(category);
+
+		size_t weightedSize = size * header->SampleWeight;
+		AllocationCounter& counter = GetThreadCounter();
+		counter.TotalAllocated.fetch_add(weightedSize, std::memory_order_relaxed);
+		counter.AllocationCount.fetch_add(header->SampleWeight, std::memory_order_relaxed);
+
+		if (header->Slot)
+		{
+			header->Slot->Stats.TotalAllocated.fetch_add(weightedSize, std::memory_order_relaxed);
+			header->Slot->Stats.AllocationCount.fetch_add(header->SampleWeight, std::memory_order_relaxed);
+		}
+
+		if (HeapProfiler::IsActive())
+			HeapProfiler::OnAllocation(weightedSize, category);
+
+		return header + 1;
 	}
 
-	void* Allocator::Allocate(size_t size, const char* category)
+	void Allocator::Free(void* location)
 	{
-		if (!s_Data) Init();
+		if (!location) return;
 
-		void* location = malloc(size);
+		AllocationHeader* header = (AllocationHeader*)location - 1;
 
+		// either a double free, or memory which never came from here: location isn't the start of a block either way,
+		// so freeing it would corrupt the heap, and leaking it is the lesser evil. This may be running inside a static
+		// destructor after the loggers have shut down, so just count it (see Memory::GetAllocationStats)
+		if (header->Magic != AllocationHeader::MagicValue)
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
-
-			Allocation& alloc = s_Data->m_AllocationMap[location];
-			alloc.Location = location;
-			alloc.Size = size;
-			alloc.Category = category;
+			s_Data.m_InvalidFreeCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
 
-			s_GlobalAllocationStats.TotalAllocated += size;
-			if (category) s_Data->m_AllocationStatsMap[category].TotalAllocated += size;
+		if (header->SampleWeight)
+		{
+			size_t weightedSize = header->Size * header->SampleWeight;
+			GetThreadCounter().TotalFreed.fetch_add(weightedSize, std::memory_order_relaxed);
+			if (header->Slot) header->Slot->Stats.TotalFreed.fetch_add(weightedSize, std::memory_order_relaxed);
 		}
 
-		return location;
+		// clear the magic value so that a double free is caught above (as long as the block hasn't been reused since)
+		header->Magic = 0;
+		free((byte*)header - header->Offset);
 	}
 
-	void* Allocator::Allocate(size_t size, const char* file, int line)
+	void Allocator::SetSamplingInterval(uint32_t interval)
 	{
-		if (!s_Data) Init();
+		s_Data.m_SamplingInterval.store(interval, std::memory_order_relaxed);
+	}
 
-		void* location = malloc(size);
+	uint32_t Allocator::GetSamplingInterval()
+	{
+		uint32_t interval = s_Data.m_SamplingInterval.load(std::memory_order_relaxed);
+		return interval > 1 ? interval : 1;
+	}
 
+	void Allocator::RecordCategoryAllocation(size_t size, const char* category)
+	{
+		if (AllocationCategorySlot* slot = GetCategorySlot(category))
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
+			slot->Stats.TotalAllocated.fetch_add(size, std::memory_order_relaxed);
+			slot->Stats.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
 
-			Allocation& alloc = s_Data->m_AllocationMap[location];
-			alloc.Location = location;
-			alloc.Size = size;
-			alloc.Category = file;
+	void Allocator::RecordCategoryFree(size_t size, const char* category)
+	{
+		if (AllocationCategorySlot* slot = GetCategorySlot(category))
+			slot->Stats.TotalFreed.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	AllocatorData::AllocationStatsMap Allocator::GetAllocationStatsMap()
+	{
+		AllocatorData::AllocationStatsMap statsMap;
 
-			s_GlobalAllocationStats.TotalAllocated += size;
-			s_Data->m_AllocationStatsMap[file].TotalAllocated += size;
+		for (const auto& slot : s_Data.m_Categories)
+		{
+			const char* category = slot.Category.load(std::memory_order_acquire);
+			if (!category) continue;
+
+			AllocationStats& stats = statsMap[category];
+			stats.TotalAllocated = slot.Stats.TotalAllocated.load(std::memory_order_relaxed);
+			stats.TotalFreed = slot.Stats.TotalFreed.load(std::memory_order_relaxed);
+			stats.AllocationCount = slot.Stats.AllocationCount.load(std::memory_order_relaxed);
 		}
 
-		return location;
+		return statsMap;
 	}
 
-	void Allocator::Free(void* location)
+	AllocationCategorySlot* Allocator::GetCategorySlot(const char* category)
 	{
-		if (!location) return;
+		if (!category) return nullptr;
 
-		bool found = false;
+		// categories are (almost always) string literals, so they are keyed by address, not contents
+		uint64_t hash = (uint64_t)category;
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
 
+		constexpr size_t mask = AllocatorData::CategoryCapacity - 1;
+
+		for (size_t probe = 0; probe < AllocatorData::CategoryCapacity; probe++)
 		{
-			std::scoped_lock<std::mutex> lock(s_Data->m_Mutex);
+			AllocationCategorySlot& slot = s_Data.m_Categories[(hash + probe) & mask];
 
-			auto mapIterator = s_Data->m_AllocationMap.find(location);
-			found = (mapIterator != s_Data->m_AllocationMap.end());
+			const char* occupant = slot.Category.load(std::memory_order_acquire);
+			if (occupant == category) return &slot;
 
-			if (found)
+			if (!occupant)
 			{
-				const Allocation& alloc = mapIterator->second;
-				s_GlobalAllocationStats.TotalFreed += alloc.Size;
-				if (alloc.Category) s_Data->m_AllocationStatsMap[alloc.Category].TotalFreed += alloc.Size;
+				if (slot.Category.compare_exchange_strong(occupant, category, std::memory_order_acq_rel))
+					return &slot;
 
-				s_Data->m_AllocationMap.erase(location);
+				// another thread claimed the slot first, possibly for this same category
+				if (occupant == category) return &slot;
 			}
 		}
 
-#ifndef Z_DIST
-		if (!found) Z_CORE_WARN("Memory location {0} not found in allocation map", location);
-#endif
+		// table is full: the allocation still counts towards the global totals
+		return nullptr;
+	}
 
-		free(location);
+	AllocationCounter& Allocator::GetThreadCounter()
+	{
+		thread_local uint32_t shard = s_Data.m_NextShard.fetch_add(1, std::memory_order_relaxed) & (AllocatorData::CounterShardCount - 1);
 
+		return s_Data.m_GlobalCounters[shard];
 	}
 
 }
@@ -196,3 +287,159 @@ void __CRTDECL operator delete[](void* location, const char* file, int line)
 
 #endif
 
+
+#if Z_TRACK_MEMORY && defined(Z_PLATFORM_LINUX)
+
+namespace
+{
+	// the throwing forms of operator new must never return null
+	inline void* CheckAllocation(void* location)
+	{
+		if (!location) throw std::bad_alloc();
+		return location;
+	}
+}
+
+void* operator new(size_t size)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size));
+}
+
+void* operator new[](size_t size)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Zahra::Allocator::Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Zahra::Allocator::Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return CheckAllocation(Zahra::Allocator::AllocateAligned(size, (size_t)alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return CheckAllocation(Zahra::Allocator::AllocateAligned(size, (size_t)alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return Zahra::Allocator::AllocateAligned(size, (size_t)alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return Zahra::Allocator::AllocateAligned(size, (size_t)alignment);
+}
+
+void* operator new(size_t size, const char* category)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size, category));
+}
+
+void* operator new[](size_t size, const char* category)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size, category));
+}
+
+void* operator new(size_t size, const char* file, int line)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size, file, line));
+}
+
+void* operator new[](size_t size, const char* file, int line)
+{
+	return CheckAllocation(Zahra::Allocator::Allocate(size, file, line));
+}
+
+// every tracked block records its own size and alignment offset, so all the delete variants collapse to Free
+
+void operator delete(void* location) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, size_t size) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, size_t size) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, const std::nothrow_t&) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, const std::nothrow_t&) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, std::align_val_t alignment) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, std::align_val_t alignment) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, size_t size, std::align_val_t alignment) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, size_t size, std::align_val_t alignment) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, const char* category) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete(void* location, const char* file, int line) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, const char* category) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+void operator delete[](void* location, const char* file, int line) noexcept
+{
+	Zahra::Allocator::Free(location);
+}
+
+#endif
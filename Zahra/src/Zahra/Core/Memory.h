@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <map>
-#include <mutex>
 #include <utility>
 
 
@@ -17,6 +19,8 @@ namespace Zahra
 	{
 		size_t TotalAllocated = 0; /**< @brief Total of allocated bytes since program start. */
 		size_t TotalFreed = 0; /**< @brief Total of freed bytes since program start. */
+		size_t AllocationCount = 0; /**< @brief Number of allocations since program start (an estimate, when sampling). */
+		size_t InvalidFreeCount = 0; /**< @brief Number of frees ignored since program start, because the location was already freed or never tracked. */
 	};
 
 	/**
@@ -32,9 +36,9 @@ namespace Zahra
 	namespace Memory
 	{
 		/**
-		 * @brief Returns the AllocationStats struct tracking the entire engine's heap memory usage.
+		 * @brief Returns a snapshot of the statistics tracking the entire engine's heap memory usage.
 		 */
-		const AllocationStats& GetAllocationStats();
+		AllocationStats GetAllocationStats();
 	}
 
 	/**
@@ -68,17 +72,55 @@ namespace Zahra
 	};
 
 	/**
-	 * @brief Struct containing engine allocation stats, and mutexes to maintain the statistics' thread-safety. Held internally in Allocator.
+	 * @brief A set of lock-free byte and allocation counters, padded out to a full cache line so that neighbouring
+	 * counters updated by different threads don't contend.
 	 */
-	struct AllocatorData
+	struct alignas(64) AllocationCounter
 	{
-		/**
-		 * @brief Specialisation of BaseAllocator used specifically to allocate m_AllocationMap at initialisation.
-		 */
-		using MapAllocator = BaseAllocator<std::pair<const void* const, Allocation>>;
+		std::atomic<size_t> TotalAllocated; /**< @brief Running total of allocated bytes. */
+		std::atomic<size_t> TotalFreed; /**< @brief Running total of freed bytes. */
+		std::atomic<size_t> AllocationCount; /**< @brief Running count of allocations. */
+	};
+
+	/**
+	 * @brief A slot in AllocatorData's category table. The Category pointer is claimed once (via compare-exchange)
+	 * by the first allocation carrying that label, and never released.
+	 */
+	struct AllocationCategorySlot
+	{
+		std::atomic<const char*> Category; /**< @brief The category label occupying this slot, or null if the slot is free. */
+		AllocationCounter Stats; /**< @brief Byte counters for this category. */
+	};
 
+	/**
+	 * @brief Intrusive header placed immediately before every tracked allocation, so that Free can recover the
+	 * allocation's size and category without consulting any shared lookup structure.
+	 *
+	 * Its size is a multiple of alignof(std::max_align_t), so the user pointer keeps malloc's alignment guarantee.
+	 */
+	struct alignas(16) AllocationHeader
+	{
+		size_t Size; /**< @brief Size of the user allocation, in bytes (not including this header). */
+		AllocationCategorySlot* Slot; /**< @brief Category table slot charged for this allocation, or null if uncategorised. */
+		uint32_t Magic; /**< @brief Set to AllocationHeader::MagicValue, used to detect frees of untracked memory. */
+		uint32_t SampleWeight; /**< @brief Multiplier applied to Size when this allocation was recorded, or 0 if sampling skipped it. */
+		uint32_t Offset; /**< @brief Distance from the start of the underlying malloc block to this header (non-zero for over-aligned allocations). */
+		uint32_t Reserved;
+
+		static constexpr uint32_t MagicValue = 0x5A414C43; // "ZALC"
+	};
+
+	/**
+	 * @brief Struct containing engine allocation stats. Held internally in Allocator.
+	 *
+	 * Every member is zero-initialised as part of static initialisation, so it is safe to use from operator new
+	 * before any dynamic initialisers have run. All updates are lock-free: global totals are spread over a set of
+	 * per-thread shards, and categories live in a fixed-capacity open-addressing table.
+	 */
+	struct AllocatorData
+	{
 		/**
-		 * @brief Specialisation of BaseAllocator used specifically to allocate m_AllocationStatsMap at initialisation.
+		 * @brief Specialisation of BaseAllocator used specifically to allocate snapshots of the category stats.
 		 */
 		using StatsMapAllocator = BaseAllocator<std::pair<const char* const, AllocationStats>>;
 
@@ -87,17 +129,34 @@ namespace Zahra
 		 */
 		using AllocationStatsMap = std::map<const char*, AllocationStats, std::less<const char*>, StatsMapAllocator>;
 
+		static constexpr size_t CounterShardCount = 16; /**< @brief Number of shards the global totals are spread over (a power of two). */
+		static constexpr size_t CategoryCapacity = 1024; /**< @brief Maximum number of distinct categories tracked (a power of two). */
+
+		/**
+		 * @brief Global allocation totals, sharded by thread.
+		 */
+		std::array<AllocationCounter, CounterShardCount> m_GlobalCounters;
+
+		/**
+		 * @brief Open-addressing table of per-category stats, keyed by category pointer.
+		 */
+		std::array<AllocationCategorySlot, CategoryCapacity> m_Categories;
+
 		/**
-		 * @brief A std::map containing the data of all engine allocations.
+		 * @brief Source of shard indices handed out to threads on their first tracked allocation.
 		 */
-		std::map<const void*, Allocation, std::less<const void*>, MapAllocator> m_AllocationMap;
+		std::atomic<uint32_t> m_NextShard;
 
 		/**
-		 * @brief An AllocationStatsMap for all tracked allocation categories.
+		 * @brief Only every Nth allocation (per thread) is recorded, or every allocation if this is 0 or 1.
 		 */
-		AllocationStatsMap m_AllocationStatsMap;
+		std::atomic<uint32_t> m_SamplingInterval;
 
-		std::mutex m_Mutex, m_StatsMutex;
+		/**
+		 * @brief Count of frees ignored because the location didn't carry a valid header. Free can run during static
+		 * destruction, after the loggers are gone, so it only counts these; Application reports them once per frame.
+		 */
+		std::atomic<size_t> m_InvalidFreeCount;
 	};
 
 	/**
@@ -107,12 +166,7 @@ namespace Zahra
 	{
 	public:
 		/**
-		 * @brief Initialises the memory manager, automatically called on first heap allocation.
-		 */
-		static void Init();
-
-		/**
-		 * @brief A primitive allocation call, for internal use during initialisation.
+		 * @brief A primitive allocation call, bypassing tracking entirely.
 		 * @return Pointer to newly allocated heap memory.
 		 */
 		static void* AllocateRaw(size_t size);
@@ -147,6 +201,17 @@ namespace Zahra
 		 */
 		static void* Allocate(size_t size, const char* file, int line);
 
+		/**
+		 * @brief A tracked, thread-safe allocation call, for alignments stricter than malloc guarantees.
+		 * 
+		 * @return Pointer to newly allocated heap memory, to be released with Free.
+		 * 
+		 * @param size Requested allocation size, in bytes.
+		 * @param alignment Requested alignment, in bytes (must be a power of two).
+		 * @param category Custom allocation label (optional).
+		 */
+		static void* AllocateAligned(size_t size, size_t alignment, const char* category = nullptr);
+
 		/**
 		 * @brief A tracked, thread-safe memory deallocation call.
 		 * 
@@ -154,16 +219,50 @@ namespace Zahra
 		 */
 		static void Free(void* location);
 
+		/**
+		 * @brief Charges bytes to a category without touching the global totals. For sub-allocators
+		 * (e.g. PoolAllocator) that carve up memory which has already been counted once.
+		 * 
+		 * @param size Number of bytes handed out.
+		 * @param category Custom allocation label.
+		 */
+		static void RecordCategoryAllocation(size_t size, const char* category);
+
+		/**
+		 * @brief Counterpart to RecordCategoryAllocation.
+		 * 
+		 * @param size Number of bytes returned.
+		 * @param category Custom allocation label.
+		 */
+		static void RecordCategoryFree(size_t size, const char* category);
+
 		/**
 		 * @brief Provides categorised heap allocation statistics.
 		 * 
-		 * @return Access to the internally-held AllocationStatsMap for all tracked allocation categories.
+		 * @return A snapshot of the stats for all tracked allocation categories. Counters are read
+		 * without locking, so the snapshot may be mid-update for allocations racing with the call.
+		 */
+		static AllocatorData::AllocationStatsMap GetAllocationStatsMap();
+
+		/**
+		 * @brief Switches to sampled tracking, in which each thread only records every Nth allocation.
+		 * 
+		 * Recorded allocations are weighted by N, so the totals remain unbiased estimates while the
+		 * per-allocation cost of tracking drops to a thread-local countdown. Suitable for long soak tests.
+		 * 
+		 * @param interval Record one allocation in every interval (0 or 1 records everything, the default).
 		 */
-		static const AllocatorData::AllocationStatsMap& GetAllocationStatsMap() { return s_Data->m_AllocationStatsMap; }
+		static void SetSamplingInterval(uint32_t interval);
+		static uint32_t GetSamplingInterval();
 
 	private:
-		inline static AllocatorData* s_Data = nullptr;
+		static void* TrackAllocation(void* block, size_t offset, size_t size, const char* category);
+		static AllocationCategorySlot* GetCategorySlot(const char* category);
+		static AllocationCounter& GetThreadCounter();
 
+		static AllocatorData s_Data;
+
+		friend AllocationStats Memory::GetAllocationStats();
 	};
 
 }
@@ -206,8 +305,32 @@ namespace Zahra
 		#define znew new(__FILE__, __LINE__)
 		#define zdelete delete
 
+	#elif defined(Z_PLATFORM_LINUX)
+
+		// The replaceable global forms (including the sized and aligned deletes) are already declared
+		// by <new>, so only the engine's placement forms need declaring here
+
+		[[nodiscard]] void* operator new(size_t size, const char* category);
+
+		[[nodiscard]] void* operator new[](size_t size, const char* category);
+
+		[[nodiscard]] void* operator new(size_t size, const char* file, int line);
+
+		[[nodiscard]] void* operator new[](size_t size, const char* file, int line);
+
+		void operator delete(void* location, const char* category) noexcept;
+
+		void operator delete(void* location, const char* file, int line) noexcept;
+
+		void operator delete[](void* location, const char* category) noexcept;
+
+		void operator delete[](void* location, const char* file, int line) noexcept;
+
+		#define znew new(__FILE__, __LINE__)
+		#define zdelete delete
+
 	#else
-		#warning "Memory tracking not available on non-Windows platform"
+		#warning "Memory tracking not available on this platform"
 		#define znew new
 		#define zdelete delete
 	#endif
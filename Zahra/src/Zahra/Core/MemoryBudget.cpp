@@ -0,0 +1,181 @@
+#include "zpch.h"
+#include "MemoryBudget.h"
+
+#include "Zahra/Core/Memory.h"
+#include "Zahra/Core/Mutex.h"
+
+#include <string_view>
+
+namespace Zahra
+{
+	struct MemoryBudgetCallbackEntry
+	{
+		uint32_t Handle;
+		std::string Name;
+		MemoryBudgetCallback Callback;
+	};
+
+	struct MemoryBudgetData
+	{
+		std::map<std::string, MemoryBudgetStatus> Budgets;
+		std::vector<MemoryBudgetCallbackEntry> Callbacks;
+		uint32_t NextCallbackHandle = 1;
+
+		// which budgets each category counts towards (categories are keyed by address, and never change
+		// contents, so this only needs rebuilding when the set of budgets changes)
+		std::unordered_map<const char*, std::vector<std::string>> CategoryMatches;
+
+		Mutex BudgetMutex{ "MemoryBudget" };
+	};
+
+	static MemoryBudgetData s_MemoryBudgetData;
+
+	namespace MemoryBudgetUtils
+	{
+		static bool IsSeparator(char c)
+		{
+			return c == '/' || c == '\\';
+		}
+
+		static bool CategoryMatches(std::string_view category, std::string_view name)
+		{
+			if (category == name) return true;
+
+			for (size_t position = category.find(name); position != std::string_view::npos; position = category.find(name, position + 1))
+			{
+				size_t end = position + name.size();
+
+				bool startsComponent = position == 0 || IsSeparator(category[position - 1]);
+				bool endsComponent = end == category.size() || IsSeparator(category[end]) || category[end] == '.';
+
+				if (startsComponent && endsComponent)
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	void MemoryBudget::Set(const std::string& name, size_t limit)
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		auto [it, inserted] = s_MemoryBudgetData.Budgets.try_emplace(name);
+		it->second.Name = name;
+		it->second.Limit = limit;
+
+		if (inserted)
+			s_MemoryBudgetData.CategoryMatches.clear();
+	}
+
+	void MemoryBudget::Remove(const std::string& name)
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		if (s_MemoryBudgetData.Budgets.erase(name))
+			s_MemoryBudgetData.CategoryMatches.clear();
+	}
+
+	uint32_t MemoryBudget::AddCallback(const std::string& name, const MemoryBudgetCallback& callback)
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		uint32_t handle = s_MemoryBudgetData.NextCallbackHandle++;
+		s_MemoryBudgetData.Callbacks.push_back({ handle, name, callback });
+
+		return handle;
+	}
+
+	void MemoryBudget::RemoveCallback(uint32_t handle)
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		auto& callbacks = s_MemoryBudgetData.Callbacks;
+		callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+			[handle](const MemoryBudgetCallbackEntry& entry) { return entry.Handle == handle; }), callbacks.end());
+	}
+
+	void MemoryBudget::Update()
+	{
+		std::vector<std::pair<MemoryBudgetCallback, MemoryBudgetStatus>> triggered;
+
+		{
+			ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+			if (s_MemoryBudgetData.Budgets.empty())
+				return;
+
+			for (auto& [name, budget] : s_MemoryBudgetData.Budgets)
+				budget.CurrentUsage = 0;
+
+			for (auto& [category, stats] : Allocator::GetAllocationStatsMap())
+			{
+				auto [it, inserted] = s_MemoryBudgetData.CategoryMatches.try_emplace(category);
+				if (inserted)
+				{
+					for (auto& [name, budget] : s_MemoryBudgetData.Budgets)
+					{
+						if (MemoryBudgetUtils::CategoryMatches(category, name))
+							it->second.push_back(name);
+					}
+				}
+
+				size_t live = stats.TotalAllocated > stats.TotalFreed ? stats.TotalAllocated - stats.TotalFreed : 0;
+
+				for (auto& name : it->second)
+					s_MemoryBudgetData.Budgets[name].CurrentUsage += live;
+			}
+
+			for (auto& [name, budget] : s_MemoryBudgetData.Budgets)
+			{
+				budget.PeakUsage = std::max(budget.PeakUsage, budget.CurrentUsage);
+
+				bool wasOverBudget = budget.OverBudget;
+				budget.OverBudget = budget.CurrentUsage > budget.Limit;
+
+				if (!budget.OverBudget || wasOverBudget)
+					continue;
+
+				budget.ExceededCount++;
+
+				Z_CORE_WARN("Memory budget '{0}' exceeded: {1} bytes in use (limit {2} bytes)", name, budget.CurrentUsage, budget.Limit);
+
+				for (auto& entry : s_MemoryBudgetData.Callbacks)
+				{
+					if (entry.Name == name)
+						triggered.emplace_back(entry.Callback, budget);
+				}
+			}
+		}
+
+		// run callbacks outside the lock, so they are free to adjust budgets or free memory
+		for (auto& [callback, status] : triggered)
+			callback(status);
+	}
+
+	std::vector<MemoryBudgetStatus> MemoryBudget::GetStatus()
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		std::vector<MemoryBudgetStatus> status;
+		status.reserve(s_MemoryBudgetData.Budgets.size());
+
+		for (auto& [name, budget] : s_MemoryBudgetData.Budgets)
+			status.push_back(budget);
+
+		return status;
+	}
+
+	bool MemoryBudget::GetStatus(const std::string& name, MemoryBudgetStatus& status)
+	{
+		ScopedLock lock(s_MemoryBudgetData.BudgetMutex);
+
+		auto it = s_MemoryBudgetData.Budgets.find(name);
+		if (it == s_MemoryBudgetData.Budgets.end())
+			return false;
+
+		status = it->second;
+		return true;
+	}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief Struct containing the state of a single memory budget.
+	 */
+	struct MemoryBudgetStatus
+	{
+		std::string Name; /**< @brief The budget's name, as passed to MemoryBudget::Set. */
+		size_t Limit = 0; /**< @brief Maximum live bytes before the budget counts as exceeded. */
+		size_t CurrentUsage = 0; /**< @brief Live bytes across all matching allocation categories, as of the last update. */
+		size_t PeakUsage = 0; /**< @brief Largest CurrentUsage seen since the budget was set. */
+		uint32_t ExceededCount = 0; /**< @brief Number of times the budget has gone from within its limit to over it. */
+		bool OverBudget = false; /**< @brief Was CurrentUsage above Limit as of the last update? */
+	};
+
+	using MemoryBudgetCallback = std::function<void(const MemoryBudgetStatus&)>;
+
+	/**
+	 * @brief Per-category limits on live heap memory, checked once per frame.
+	 *
+	 * A budget applies to every allocation category that either equals its name, or is a source filepath (as
+	 * produced by znew) containing its name as a directory or file stem. So a budget named "Scripting" covers
+	 * everything allocated from Zahra/Scripting/, and one named "Renderer2D" covers Renderer2D.h and .cpp.
+	 *
+	 * When a budget is first exceeded a warning is logged and its callbacks are run (on the main thread, at the top
+	 * of the frame), giving e.g. asset caches a chance to evict before memory runs out. The callbacks won't fire
+	 * again until usage has dropped back within the limit. Requires Z_TRACK_MEMORY, otherwise usage is always 0.
+	 */
+	class MemoryBudget
+	{
+	public:
+		/**
+		 * @brief Create a budget, or change the limit of an existing one.
+		 *
+		 * @param name Allocation category (or source directory/file stem) to be budgeted.
+		 * @param limit Maximum live bytes.
+		 */
+		static void Set(const std::string& name, size_t limit);
+		static void Remove(const std::string& name);
+
+		/**
+		 * @brief Register a function to be called whenever the named budget is exceeded.
+		 *
+		 * @return A handle for use with RemoveCallback.
+		 */
+		static uint32_t AddCallback(const std::string& name, const MemoryBudgetCallback& callback);
+		static void RemoveCallback(uint32_t handle);
+
+		/**
+		 * @brief Recompute usage for all budgets and fire any callbacks. Called by Application once per frame.
+		 */
+		static void Update();
+
+		/**
+		 * @brief The state of all budgets, as of the last update, ordered by name.
+		 */
+		static std::vector<MemoryBudgetStatus> GetStatus();
+
+		/**
+		 * @brief The state of the named budget, as of the last update.
+		 *
+		 * @return False if there is no budget with this name.
+		 */
+		static bool GetStatus(const std::string& name, MemoryBudgetStatus& status);
+	};
+
+}
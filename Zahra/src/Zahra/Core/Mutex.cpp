@@ -0,0 +1,188 @@
+#include "zpch.h"
+#include "Mutex.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace Zahra
+{
+#if Z_PROFILING_ENABLED
+
+	struct alignas(64) LockCounters
+	{
+		const char* Name = nullptr;
+		char WaitScopeName[64] = {};
+		char HoldScopeName[64] = {};
+
+		std::atomic<uint64_t> Acquisitions = 0;
+		std::atomic<uint64_t> Contentions = 0;
+		std::atomic<int64_t> TotalWait = 0;
+		std::atomic<int64_t> MaxWait = 0;
+		std::atomic<int64_t> TotalHold = 0;
+		std::atomic<int64_t> MaxHold = 0;
+	};
+
+	// Note: everything here is constant-initialised, so locks are usable during static initialisation
+	struct LockRegistryData
+	{
+		static constexpr uint32_t Capacity = 128; // beyond which new names share the last entry
+
+		std::mutex Mutex;
+		LockCounters Entries[Capacity];
+		std::atomic<uint32_t> Count = 0;
+	};
+
+	static LockRegistryData s_LockRegistryData;
+
+	namespace MutexUtils
+	{
+		static LockCounters& Register(const char* name)
+		{
+			std::scoped_lock<std::mutex> lock(s_LockRegistryData.Mutex);
+
+			uint32_t count = s_LockRegistryData.Count.load(std::memory_order_relaxed);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (strcmp(s_LockRegistryData.Entries[i].Name, name) == 0)
+					return s_LockRegistryData.Entries[i];
+			}
+
+			if (count == LockRegistryData::Capacity)
+				return s_LockRegistryData.Entries[count - 1];
+
+			LockCounters& counters = s_LockRegistryData.Entries[count];
+			counters.Name = name;
+			snprintf(counters.WaitScopeName, sizeof(counters.WaitScopeName), "Lock wait: %s", name);
+			snprintf(counters.HoldScopeName, sizeof(counters.HoldScopeName), "Lock hold: %s", name);
+
+			s_LockRegistryData.Count.store(count + 1, std::memory_order_release);
+			return counters;
+		}
+
+		static void AtomicMax(std::atomic<int64_t>& target, int64_t value)
+		{
+			int64_t current = target.load(std::memory_order_relaxed);
+			while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed));
+		}
+	}
+
+	void Mutex::lock()
+	{
+		LockCounters& counters = GetCounters();
+
+		if (m_Mutex.try_lock())
+		{
+			m_LockedAt = Instrumentor::GetTimestamp();
+		}
+		else
+		{
+			int64_t waitStart = Instrumentor::GetTimestamp();
+
+			// counted until acquired, so that the holder knows it kept someone waiting
+			m_Waiters.fetch_add(1, std::memory_order_relaxed);
+			m_Mutex.lock();
+			m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+
+			m_LockedAt = Instrumentor::GetTimestamp();
+			int64_t wait = m_LockedAt - waitStart;
+
+			counters.Contentions.fetch_add(1, std::memory_order_relaxed);
+			counters.TotalWait.fetch_add(wait, std::memory_order_relaxed);
+			MutexUtils::AtomicMax(counters.MaxWait, wait);
+
+			Instrumentor::WriteProfile({ counters.WaitScopeName, waitStart, m_LockedAt, ProfilingUtils::t_ScopeDepth });
+		}
+
+		counters.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool Mutex::try_lock()
+	{
+		if (!m_Mutex.try_lock())
+			return false;
+
+		m_LockedAt = Instrumentor::GetTimestamp();
+		GetCounters().Acquisitions.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void Mutex::unlock()
+	{
+		int64_t lockedAt = m_LockedAt;
+		int64_t unlockedAt = Instrumentor::GetTimestamp();
+		bool keptWaiting = m_Waiters.load(std::memory_order_relaxed) > 0;
+
+		m_Mutex.unlock();
+
+		LockCounters& counters = GetCounters();
+		int64_t hold = unlockedAt - lockedAt;
+
+		counters.TotalHold.fetch_add(hold, std::memory_order_relaxed);
+		MutexUtils::AtomicMax(counters.MaxHold, hold);
+
+		// only the holds that held someone else up, or every pool allocation would show up in traces
+		if (keptWaiting)
+			Instrumentor::WriteProfile({ counters.HoldScopeName, lockedAt, unlockedAt, ProfilingUtils::t_ScopeDepth });
+	}
+
+	LockCounters& Mutex::GetCounters()
+	{
+		LockCounters* counters = m_Counters.load(std::memory_order_acquire);
+		if (!counters)
+		{
+			counters = &MutexUtils::Register(m_Name);
+			m_Counters.store(counters, std::memory_order_release);
+		}
+
+		return *counters;
+	}
+
+	void Mutex::GetLockStats(std::vector<LockStats>& stats)
+	{
+		uint32_t count = s_LockRegistryData.Count.load(std::memory_order_acquire);
+		stats.resize(count);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const LockCounters& counters = s_LockRegistryData.Entries[i];
+
+			stats[i].Name = counters.Name;
+			stats[i].Acquisitions = counters.Acquisitions.load(std::memory_order_relaxed);
+			stats[i].Contentions = counters.Contentions.load(std::memory_order_relaxed);
+			stats[i].TotalWait = counters.TotalWait.load(std::memory_order_relaxed);
+			stats[i].MaxWait = counters.MaxWait.load(std::memory_order_relaxed);
+			stats[i].TotalHold = counters.TotalHold.load(std::memory_order_relaxed);
+			stats[i].MaxHold = counters.MaxHold.load(std::memory_order_relaxed);
+		}
+	}
+
+	void Mutex::ResetLockStats()
+	{
+		uint32_t count = s_LockRegistryData.Count.load(std::memory_order_acquire);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			LockCounters& counters = s_LockRegistryData.Entries[i];
+
+			counters.Acquisitions.store(0, std::memory_order_relaxed);
+			counters.Contentions.store(0, std::memory_order_relaxed);
+			counters.TotalWait.store(0, std::memory_order_relaxed);
+			counters.MaxWait.store(0, std::memory_order_relaxed);
+			counters.TotalHold.store(0, std::memory_order_relaxed);
+			counters.MaxHold.store(0, std::memory_order_relaxed);
+		}
+	}
+
+#else
+
+	void Mutex::GetLockStats(std::vector<LockStats>& stats)
+	{
+		stats.clear();
+	}
+
+	void Mutex::ResetLockStats()
+	{
+	}
+
+#endif
+}
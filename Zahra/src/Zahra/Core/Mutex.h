@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Zahra/Debug/Profiling.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief Totals for every Mutex sharing one name, since startup (or the last reset). All times in nanoseconds.
+	 */
+	struct LockStats
+	{
+		const char* Name = nullptr;
+		uint64_t Acquisitions = 0;
+		uint64_t Contentions = 0; /**< @brief Acquisitions which had to wait for another thread to unlock. */
+		int64_t TotalWait = 0;
+		int64_t MaxWait = 0;
+		int64_t TotalHold = 0;
+		int64_t MaxHold = 0;
+	};
+
+	struct LockCounters;
+
+	/**
+	 * @brief A std::mutex which, in builds with Z_PROFILING_ENABLED, records how long threads wait for it and hold it,
+	 * and how often they find it already locked. Stats are kept per name, so every lock of a kind (e.g. each job
+	 * queue's) can share one. Contended waits, and holds which kept another thread waiting, are also written to the
+	 * Instrumentor as "Lock wait: <name>" and "Lock hold: <name>" scopes.
+	 *
+	 * Otherwise it compiles down to a plain std::mutex. Either way it's constant-initialised, so it can guard data
+	 * used during static initialisation, and it meets the Lockable requirements, so works with std::unique_lock and
+	 * std::condition_variable_any as well as ScopedLock.
+	 */
+	class Mutex
+	{
+	public:
+#if Z_PROFILING_ENABLED
+		/**
+		 * @param name Must outlive the program (e.g. a string literal).
+		 */
+		constexpr Mutex(const char* name)
+			: m_Name(name) {}
+
+		void lock();
+		bool try_lock();
+		void unlock();
+
+		const char* GetName() const { return m_Name; }
+#else
+		constexpr Mutex(const char*) {}
+
+		void lock() { m_Mutex.lock(); }
+		bool try_lock() { return m_Mutex.try_lock(); }
+		void unlock() { m_Mutex.unlock(); }
+
+		const char* GetName() const { return ""; }
+#endif
+
+		Mutex(const Mutex&) = delete;
+		Mutex& operator=(const Mutex&) = delete;
+
+		/**
+		 * @brief Copy the stats for every named lock used so far (nothing unless Z_PROFILING_ENABLED).
+		 */
+		static void GetLockStats(std::vector<LockStats>& stats);
+		static void ResetLockStats();
+
+	private:
+		std::mutex m_Mutex;
+
+#if Z_PROFILING_ENABLED
+		const char* m_Name;
+		std::atomic<LockCounters*> m_Counters = nullptr; // looked up on first use, as registering allocates
+		std::atomic<uint32_t> m_Waiters = 0;
+		int64_t m_LockedAt = 0; // only touched by the thread holding the lock
+
+		LockCounters& GetCounters();
+#endif
+	};
+
+	/**
+	 * @brief Holds a Mutex locked for the lifetime of the object.
+	 */
+	class ScopedLock
+	{
+	public:
+		ScopedLock(Mutex& mutex)
+			: m_Mutex(mutex)
+		{
+			m_Mutex.lock();
+		}
+
+		~ScopedLock()
+		{
+			m_Mutex.unlock();
+		}
+
+		ScopedLock(const ScopedLock&) = delete;
+		ScopedLock& operator=(const ScopedLock&) = delete;
+
+	private:
+		Mutex& m_Mutex;
+	};
+
+}
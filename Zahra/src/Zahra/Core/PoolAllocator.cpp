@@ -0,0 +1,127 @@
+#include "zpch.h"
+#include "PoolAllocator.h"
+
+#include "Zahra/Core/Memory.h"
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Core/Types.h"
+
+namespace Zahra
+{
+	// Note: everything here is constant-initialised, so the pool is usable during static initialisation
+	struct PoolSizeClass
+	{
+		Mutex SizeClassMutex{ "PoolAllocator" };
+
+		void* FreeList = nullptr; // intrusive singly-linked list threaded through the free blocks themselves
+		void* Slabs = nullptr; // likewise, the first word of each slab points to the previous slab
+
+		byte* SlabCursor = nullptr; // next uncarved block in the newest slab
+		byte* SlabEnd = nullptr;
+
+		size_t BlocksReserved = 0;
+		size_t BlocksInUse = 0;
+
+		char Category[32] = {};
+	};
+
+	static PoolSizeClass s_SizeClasses[PoolAllocator::SizeClassCount];
+
+	static constexpr const char* s_SlabCategory = "PoolAllocator";
+
+	static size_t GetSizeClassIndex(size_t size)
+	{
+		return (size + PoolAllocator::SizeClassGranularity - 1) / PoolAllocator::SizeClassGranularity - 1;
+	}
+
+	void* PoolAllocator::Allocate(size_t size)
+	{
+		if (size == 0) size = 1;
+
+		if (size > MaxBlockSize)
+			return ::operator new(size);
+
+		size_t index = GetSizeClassIndex(size);
+		size_t blockSize = (index + 1) * SizeClassGranularity;
+		PoolSizeClass& sizeClass = s_SizeClasses[index];
+
+		void* block = nullptr;
+		{
+			ScopedLock lock(sizeClass.SizeClassMutex);
+
+			if (sizeClass.FreeList)
+			{
+				block = sizeClass.FreeList;
+				sizeClass.FreeList = *(void**)block;
+			}
+			else
+			{
+				if (sizeClass.SlabCursor + blockSize > sizeClass.SlabEnd)
+				{
+					if (!sizeClass.Slabs)
+						snprintf(sizeClass.Category, sizeof(sizeClass.Category), "PoolAllocator (%zu bytes)", blockSize);
+
+					// the slab header is a full granule, so that blocks keep malloc's alignment
+					byte* slab = (byte*)Allocator::Allocate(SlabSize, s_SlabCategory);
+					*(void**)slab = sizeClass.Slabs;
+					sizeClass.Slabs = slab;
+
+					sizeClass.SlabCursor = slab + SizeClassGranularity;
+					sizeClass.SlabEnd = slab + SlabSize;
+				}
+
+				block = sizeClass.SlabCursor;
+				sizeClass.SlabCursor += blockSize;
+				sizeClass.BlocksReserved++;
+			}
+
+			sizeClass.BlocksInUse++;
+		}
+
+		Allocator::RecordCategoryAllocation(blockSize, sizeClass.Category);
+
+		return block;
+	}
+
+	void PoolAllocator::Free(void* location, size_t size)
+	{
+		if (!location) return;
+
+		if (size == 0) size = 1;
+
+		if (size > MaxBlockSize)
+		{
+			::operator delete(location);
+			return;
+		}
+
+		size_t index = GetSizeClassIndex(size);
+		PoolSizeClass& sizeClass = s_SizeClasses[index];
+
+		{
+			ScopedLock lock(sizeClass.SizeClassMutex);
+
+			*(void**)location = sizeClass.FreeList;
+			sizeClass.FreeList = location;
+
+			sizeClass.BlocksInUse--;
+		}
+
+		Allocator::RecordCategoryFree((index + 1) * SizeClassGranularity, sizeClass.Category);
+	}
+
+	PoolSizeClassStats PoolAllocator::GetSizeClassStats(size_t sizeClass)
+	{
+		Z_CORE_ASSERT(sizeClass < SizeClassCount);
+
+		PoolSizeClass& data = s_SizeClasses[sizeClass];
+		ScopedLock lock(data.SizeClassMutex);
+
+		PoolSizeClassStats stats;
+		stats.BlockSize = (sizeClass + 1) * SizeClassGranularity;
+		stats.BlocksReserved = data.BlocksReserved;
+		stats.BlocksInUse = data.BlocksInUse;
+
+		return stats;
+	}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Zahra
+{
+	/**
+	 * @brief Struct containing the occupancy of a single PoolAllocator size class.
+	 */
+	struct PoolSizeClassStats
+	{
+		size_t BlockSize = 0; /**< @brief Size of each block in this class, in bytes. */
+		size_t BlocksReserved = 0; /**< @brief Number of blocks carved out of slabs so far. */
+		size_t BlocksInUse = 0; /**< @brief Number of blocks currently handed out. */
+	};
+
+	/**
+	 * @brief A thread-safe slab allocator for small, fixed-size objects.
+	 *
+	 * Requests are rounded up to one of a set of size classes (multiples of SizeClassGranularity, up to
+	 * MaxBlockSize), each with its own free list and lock. Slabs are never returned to the heap, so repeatedly
+	 * creating and destroying objects of similar sizes settles into zero heap traffic. Larger requests fall
+	 * through to the global allocator.
+	 *
+	 * The slabs themselves are tracked under the "PoolAllocator" category, while the bytes handed out from each
+	 * size class are reported as their own AllocationStatsMap category (e.g. "PoolAllocator (64 bytes)").
+	 *
+	 * Classes opt in by adding Z_POOL_ALLOCATED() to their declaration, after which Ref<T>::Create, znew and plain
+	 * new all draw from the pool. Because the operators are inherited and delete is sized, derived classes are
+	 * pooled too, and deleting through a base pointer with a virtual destructor returns the block to the right class.
+	 */
+	class PoolAllocator
+	{
+	public:
+		static constexpr size_t SizeClassGranularity = 16;
+		static constexpr size_t MaxBlockSize = 512;
+		static constexpr size_t SizeClassCount = MaxBlockSize / SizeClassGranularity;
+		static constexpr size_t SlabSize = 64 * 1024;
+
+		/**
+		 * @brief Allocate a block of at least the given size (falls back to the global allocator above MaxBlockSize).
+		 */
+		static void* Allocate(size_t size);
+
+		/**
+		 * @brief Return a block previously obtained from Allocate with the same size.
+		 */
+		static void Free(void* location, size_t size);
+
+		/**
+		 * @brief Occupancy of the size class with the given index (from 0 to SizeClassCount - 1).
+		 */
+		static PoolSizeClassStats GetSizeClassStats(size_t sizeClass);
+	};
+
+}
+
+// Note: the placement deletes only run if a constructor throws, in which case the block is leaked
+// (they aren't given the allocation size, so can't safely return it to its size class)
+#define Z_POOL_ALLOCATED() \
+	static void* operator new(size_t size) { return ::Zahra::PoolAllocator::Allocate(size); } \
+	static void* operator new(size_t size, const char* category) { return ::Zahra::PoolAllocator::Allocate(size); } \
+	static void* operator new(size_t size, const char* file, int line) { return ::Zahra::PoolAllocator::Allocate(size); } \
+	static void* operator new(size_t size, void* location) noexcept { return location; } \
+	static void operator delete(void* location, size_t size) { ::Zahra::PoolAllocator::Free(location, size); } \
+	static void operator delete(void* location, const char* category) {} \
+	static void operator delete(void* location, const char* file, int line) {} \
+	static void operator delete(void* location, void* placement) noexcept {}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Zahra/Core/Assert.h"
 #include "Zahra/Core/Memory.h"
 
 #include <memory>
@@ -18,19 +19,34 @@ namespace Zahra
 			m_RefCount++;
 		}
 
-		void DecrementRefCount() const
+		// returns the updated count, so that exactly one thread sees it reach zero
+		uint32_t DecrementRefCount() const
 		{
-			m_RefCount--;
+			return --m_RefCount;
 		}
 
 		uint32_t GetRefCount() const { return m_RefCount.load(); }
 
+#ifdef Z_DEBUG
+		// debug builds count live RefViews, to catch any which outlive the object they borrow
+		void IncrementBorrowCount() const { m_BorrowCount++; }
+		void DecrementBorrowCount() const { m_BorrowCount--; }
+		uint32_t GetBorrowCount() const { return m_BorrowCount.load(); }
+#endif
+
 	private:
 		// using std::atomic ensures the thread safety
 		// of incrementing/decrementing the ref count
 		mutable std::atomic<uint32_t> m_RefCount = 0;
+
+#ifdef Z_DEBUG
+		mutable std::atomic<uint32_t> m_BorrowCount = 0;
+#endif
 	};
 
+	template<typename T>
+	class RefView;
+
 	template<typename T>
 	class Ref
 	{
@@ -162,10 +178,17 @@ namespace Zahra
 			return Ref<T2>(*this);
 		}
 
+		// cast without touching the ref count (see RefView)
+		template<typename T2>
+		RefView<T2> AsView() const
+		{
+			return RefView<T2>((T2*)m_Raw);
+		}
+
 		template<typename... Args>
 		static Ref<T> Create(Args&&... args)
 		{
-#if Z_TRACK_MEMORY && defined(Z_PLATFORM_WINDOWS)
+#if Z_TRACK_MEMORY && (defined(Z_PLATFORM_WINDOWS) || defined(Z_PLATFORM_LINUX))
 			return Ref<T>(new(typeid(T).name()) T(std::forward<Args>(args)...));
 #else
 			return Ref<T>(new T(std::forward<Args>(args)...));
@@ -202,10 +225,11 @@ namespace Zahra
 		{
 			if (m_Raw)
 			{
-				m_Raw->DecrementRefCount();
-
-				if (m_Raw->GetRefCount() == 0)
+				if (m_Raw->DecrementRefCount() == 0)
 				{
+#ifdef Z_DEBUG
+					Z_CORE_ASSERT(m_Raw->GetBorrowCount() == 0, "Deleting an object which is still borrowed by a RefView");
+#endif
 					delete m_Raw;
 					m_Raw = nullptr;
 				}
@@ -214,9 +238,120 @@ namespace Zahra
 
 		template<class T2>
 		friend class Ref;
+		template<class T2>
+		friend class RefView;
 		mutable T* m_Raw;
 	};
 
+	/**
+	 * @brief A non-owning reference to a RefCounted object, for passing objects down hot paths without paying for
+	 * an atomic increment and decrement (and the contended cache line that comes with them) on every copy.
+	 *
+	 * A RefView must not outlive every Ref to its object, so use it for parameters and locals, never for storage.
+	 * Debug builds count live views on the object, and assert if it is deleted while any remain. Call ToRef() to
+	 * take shared ownership when the object needs to be kept.
+	 */
+	template<typename T>
+	class RefView
+	{
+	public:
+		RefView() = default;
+
+		RefView(std::nullptr_t) {}
+
+		explicit RefView(T* instance)
+			: m_Raw(instance)
+		{
+			Borrow();
+		}
+
+		template<typename T2>
+		RefView(const Ref<T2>& ref)
+			: m_Raw(ref.m_Raw)
+		{
+			Borrow();
+		}
+
+		template<typename T2>
+		RefView(const RefView<T2>& other)
+			: m_Raw(other.m_Raw)
+		{
+			Borrow();
+		}
+
+		RefView(const RefView<T>& other)
+			: m_Raw(other.m_Raw)
+		{
+			Borrow();
+		}
+
+		RefView& operator=(const RefView<T>& other)
+		{
+			if (this == &other)
+				return *this;
+
+			Release();
+			m_Raw = other.m_Raw;
+			Borrow();
+			return *this;
+		}
+
+		~RefView()
+		{
+			Release();
+		}
+
+		operator bool() const { return m_Raw != nullptr; }
+
+		T* operator->() const { return m_Raw; }
+		T& operator*() const { return *m_Raw; }
+
+		T* Raw() const { return m_Raw; }
+
+		Ref<T> ToRef() const { return Ref<T>(m_Raw); }
+
+		template<typename T2>
+		RefView<T2> As() const
+		{
+			return RefView<T2>((T2*)m_Raw);
+		}
+
+		bool operator==(const RefView<T>& other) const
+		{
+			return m_Raw == other.m_Raw;
+		}
+
+		bool operator!=(const RefView<T>& other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		void Borrow() const
+		{
+#ifdef Z_DEBUG
+			if (m_Raw)
+			{
+				Z_CORE_ASSERT(m_Raw->GetRefCount() > 0, "RefView of an object which isn't owned by any Ref");
+				m_Raw->IncrementBorrowCount();
+			}
+#endif
+		}
+
+		void Release() const
+		{
+#ifdef Z_DEBUG
+			if (m_Raw)
+				m_Raw->DecrementBorrowCount();
+#endif
+		}
+
+		T* m_Raw = nullptr;
+
+		template<class T2>
+		friend class RefView;
+	};
+
 	template<typename T>
 	class WeakRef
 	{
@@ -0,0 +1,16 @@
+#include "zpch.h"
+#include "Task.h"
+
+#include "Zahra/Core/Application.h"
+
+namespace Zahra
+{
+	namespace TaskUtils
+	{
+		void SubmitToMainThread(const std::function<void()>& command)
+		{
+			Application::Get().SubmitToMainThread(command);
+		}
+	}
+
+}
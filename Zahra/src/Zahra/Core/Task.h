@@ -0,0 +1,248 @@
+#pragma once
+
+#include "Zahra/Core/Assert.h"
+#include "Zahra/Core/JobSystem.h"
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Core/Ref.h"
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Zahra
+{
+	namespace TaskUtils
+	{
+		// stands in for the "value" of a Task<void>
+		struct Unit {};
+
+		template<typename T>
+		using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+		template<typename F, typename T>
+		struct ContinuationResult { using Type = std::invoke_result_t<F&, T&>; };
+
+		template<typename F>
+		struct ContinuationResult<F, void> { using Type = std::invoke_result_t<F&>; };
+
+		// call a continuation with the previous stage's value (or nothing, if it was void)
+		template<typename R, typename F, typename T>
+		Stored<R> Invoke(F& func, Stored<T>& value)
+		{
+			if constexpr (std::is_void_v<T>)
+			{
+				if constexpr (std::is_void_v<R>) { func(); return {}; }
+				else return func();
+			}
+			else
+			{
+				if constexpr (std::is_void_v<R>) { func(value); return {}; }
+				else return func(value);
+			}
+		}
+
+		// defined in Task.cpp, to keep Application.h out of this header
+		void SubmitToMainThread(const std::function<void()>& command);
+	}
+
+	/**
+	 * @brief Shared completion state behind a Task.
+	 */
+	template<typename T>
+	class TaskState : public RefCounted
+	{
+	public:
+		void Complete(TaskUtils::Stored<T>&& value)
+		{
+			std::vector<std::function<void()>> continuations;
+			{
+				ScopedLock lock(m_Mutex);
+				m_Value.emplace(std::move(value));
+				m_Ready.store(true, std::memory_order_release);
+				continuations.swap(m_Continuations);
+			}
+
+			for (auto& continuation : continuations)
+				continuation();
+		}
+
+		// runs immediately (on the calling thread) if the task has already completed
+		void OnComplete(const std::function<void()>& continuation)
+		{
+			{
+				ScopedLock lock(m_Mutex);
+				if (!m_Ready.load(std::memory_order_relaxed))
+				{
+					m_Continuations.push_back(continuation);
+					return;
+				}
+			}
+
+			continuation();
+		}
+
+		bool IsReady() const { return m_Ready.load(std::memory_order_acquire); }
+		TaskUtils::Stored<T>& GetValue() { return *m_Value; }
+
+	private:
+		Mutex m_Mutex{ "Task" };
+		std::optional<TaskUtils::Stored<T>> m_Value;
+		std::atomic<bool> m_Ready = false;
+		std::vector<std::function<void()>> m_Continuations;
+	};
+
+	/**
+	 * @brief The eventual result of a chain of asynchronous work, each stage of which runs either on a
+	 * JobSystem worker or on the main thread (at the top of the next frame).
+	 *
+	 * Multi-stage work can be written as a linear chain, without blocking the frame, e.g.
+	 *
+	 *     Async::Run([path]() { return Decode(FileIO::ReadBuffer(path)); })
+	 *         .ThenOnMainThread([](Image& image) { return Upload(image); });
+	 *
+	 * Each continuation receives a reference to the previous stage's result (or no arguments if it was void),
+	 * and must be copyable. The engine is C++17, so this is continuation-based rather than a coroutine type.
+	 */
+	template<typename T>
+	class Task
+	{
+	public:
+		Task() = default;
+
+		/**
+		 * @brief A task which has already completed with the given value.
+		 */
+		template<typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		static Task<T> FromValue(U value)
+		{
+			Task<T> task = Pending();
+			task.m_State->Complete(std::move(value));
+			return task;
+		}
+
+		template<typename U = T, std::enable_if_t<std::is_void_v<U>, int> = 0>
+		static Task<T> Completed()
+		{
+			Task<T> task = Pending();
+			task.m_State->Complete({});
+			return task;
+		}
+
+		bool IsValid() const { return (bool)m_State; }
+		bool IsReady() const { return m_State && m_State->IsReady(); }
+
+		/**
+		 * @brief Block until the task has completed, running queued jobs on this thread in the meantime.
+		 * Never wait on the main thread for a task with a pending main-thread stage, as it would never run.
+		 */
+		void Wait() const
+		{
+			Z_CORE_ASSERT(m_State, "Waiting on an empty Task");
+
+			while (!m_State->IsReady())
+			{
+				if (!JobSystem::RunPendingJob())
+					std::this_thread::yield();
+			}
+		}
+
+		template<typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+		U& Get() const
+		{
+			Wait();
+
+			Ref<TaskState<T>> state = m_State;
+			return state->GetValue();
+		}
+
+		/**
+		 * @brief Run func on a JobSystem worker once this task has completed.
+		 *
+		 * @param name Label for the job's profiling scope (must outlive the job, e.g. a string literal).
+		 */
+		template<typename F>
+		auto Then(F func, const char* name = "Task") const
+		{
+			using R = typename TaskUtils::ContinuationResult<F, T>::Type;
+
+			return Continue<R>([func, name](Ref<TaskState<T>> state, Ref<TaskState<R>> next)
+				{
+					JobSystem::Schedule([func, state, next]() mutable
+						{
+							next->Complete(TaskUtils::Invoke<R, F, T>(func, state->GetValue()));
+						}, name);
+				});
+		}
+
+		/**
+		 * @brief Run func on the main thread (at the top of the next frame) once this task has completed.
+		 * For work that must happen there, e.g. submitting to the renderer or touching the active scene.
+		 */
+		template<typename F>
+		auto ThenOnMainThread(F func) const
+		{
+			using R = typename TaskUtils::ContinuationResult<F, T>::Type;
+
+			return Continue<R>([func](Ref<TaskState<T>> state, Ref<TaskState<R>> next)
+				{
+					TaskUtils::SubmitToMainThread([func, state, next]() mutable
+						{
+							next->Complete(TaskUtils::Invoke<R, F, T>(func, state->GetValue()));
+						});
+				});
+		}
+
+	private:
+		static Task<T> Pending()
+		{
+			Task<T> task;
+			task.m_State = Ref<TaskState<T>>::Create();
+			return task;
+		}
+
+		template<typename R, typename Dispatcher>
+		Task<R> Continue(Dispatcher dispatch) const
+		{
+			Z_CORE_ASSERT(m_State, "Continuing an empty Task");
+
+			Task<R> next = Task<R>::Pending();
+
+			Ref<TaskState<T>> state = m_State;
+			Ref<TaskState<R>> nextState = next.m_State;
+			state->OnComplete([dispatch, state, nextState]() { dispatch(state, nextState); });
+
+			return next;
+		}
+
+		Ref<TaskState<T>> m_State;
+
+		template<typename>
+		friend class Task;
+	};
+
+	namespace Async
+	{
+		/**
+		 * @brief Start a task chain on a JobSystem worker.
+		 */
+		template<typename F>
+		auto Run(F func, const char* name = "Task")
+		{
+			return Task<void>::Completed().Then(std::move(func), name);
+		}
+
+		/**
+		 * @brief Start a task chain on the main thread, at the top of the next frame.
+		 */
+		template<typename F>
+		auto RunOnMainThread(F func)
+		{
+			return Task<void>::Completed().ThenOnMainThread(std::move(func));
+		}
+	}
+
+}
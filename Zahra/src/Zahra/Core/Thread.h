@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Zahra/Debug/Profiling.h"
+
+#include <functional>
 #include <string>
 #include <thread>
 
@@ -13,8 +16,12 @@ namespace Zahra
 		template<typename Fn, typename... Args>
 		void Dispatch(Fn&& func, Args&&... args)
 		{
-			m_Thread = std::thread(func, std::forward<Args>(args)...);
-			SetName(m_Name);
+			m_Thread = std::thread([name = m_Name](auto&& threadFunc, auto&&... threadArgs)
+				{
+					Z_PROFILE_THREAD(name);
+					std::invoke(threadFunc, threadArgs...);
+				}, std::forward<Fn>(func), std::forward<Args>(args)...);
+			SetNativeData(m_Name);
 		}
 
 		void Join();
@@ -1,18 +1,71 @@
 #include "zpch.h"
 #include "UUID.h"
 
+#include <chrono>
 #include <random>
+#include <thread>
 
 namespace Zahra
 {
-	static std::random_device s_RandomDevice;
-	static std::mt19937_64 s_Engine(s_RandomDevice());
-	static std::uniform_int_distribution<uint64_t> s_UniformDistribution;
+	namespace UUIDUtils
+	{
+		// splitmix64, used to expand a single seed into a full xoshiro state
+		static uint64_t SplitMix64(uint64_t& state)
+		{
+			uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
 
-	// TODO: update the implementation when we add multithreading,
-	// in order to maintain uniqueness across threads
-	UUID::UUID() 
-		: m_UUID(s_UniformDistribution(s_Engine)) {}
+		static uint64_t RotateLeft(uint64_t x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
 
-}
+		// xoshiro256**, with one generator per thread so that no synchronisation is needed
+		struct Generator
+		{
+			uint64_t State[4];
+
+			Generator()
+			{
+				// mix hardware entropy with the thread id and time, in case random_device is deterministic
+				std::random_device randomDevice;
+				uint64_t seed = ((uint64_t)randomDevice() << 32) ^ randomDevice();
+				seed ^= (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+				seed ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+				for (auto& word : State)
+					word = SplitMix64(seed);
+			}
+
+			uint64_t Next()
+			{
+				uint64_t result = RotateLeft(State[1] * 5, 7) * 9;
+				uint64_t t = State[1] << 17;
+
+				State[2] ^= State[0];
+				State[3] ^= State[1];
+				State[1] ^= State[2];
+				State[0] ^= State[3];
+				State[2] ^= t;
+				State[3] = RotateLeft(State[3], 45);
 
+				return result;
+			}
+		};
+
+		static thread_local Generator t_Generator;
+	}
+
+	UUID::UUID()
+	{
+		// zero is reserved as the "null" id (e.g. for unset asset handles)
+		do
+		{
+			m_UUID = UUIDUtils::t_Generator.Next();
+		} while (m_UUID == 0);
+	}
+
+}
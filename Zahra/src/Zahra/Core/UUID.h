@@ -13,7 +13,7 @@ namespace Zahra
 	{
 	public:
 		/**
-		 * @brief Default constructor, generating pseudorandom id value.
+		 * @brief Default constructor, generating pseudorandom (non-zero) id value. Thread-safe, as each thread has its own generator.
 		 */
 		UUID();
 
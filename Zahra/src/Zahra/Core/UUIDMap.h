@@ -0,0 +1,239 @@
+#pragma once
+
+#include "Zahra/Core/Assert.h"
+#include "Zahra/Core/UUID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief An open-addressing hash map keyed on UUID, for lookups on hot paths (e.g. entity lookups from script
+	 * internal calls), where std::unordered_map's node-per-entry layout costs a cache miss or two per find.
+	 *
+	 * Entries live inline in a single power-of-two array, probed linearly from a Fibonacci hash of the key, and
+	 * erasure shifts later entries back rather than leaving tombstones, so lookups never degrade over time. A zero
+	 * key marks an empty slot, so the (unlikely) zero UUID is stored separately.
+	 *
+	 * Pointers returned by Find are invalidated by any insertion or erasure.
+	 */
+	template<typename T>
+	class UUIDMap
+	{
+	public:
+		UUIDMap() = default;
+
+		/**
+		 * @brief Find the value stored under a key, inserting a default-constructed one if there isn't one yet.
+		 */
+		T& operator[](UUID key)
+		{
+			uint64_t id = key;
+			if (id == 0)
+			{
+				if (!m_HasZeroKey)
+				{
+					m_HasZeroKey = true;
+					m_ZeroValue = T();
+					m_Size++;
+				}
+
+				return m_ZeroValue;
+			}
+
+			if ((m_Size + 1) * c_MaxLoadDenominator > m_Slots.size() * c_MaxLoadNumerator)
+				Rehash(m_Slots.empty() ? c_MinCapacity : m_Slots.size() * 2);
+
+			size_t mask = m_Slots.size() - 1;
+			for (size_t i = Hash(id); ; i = (i + 1) & mask)
+			{
+				Slot& slot = m_Slots[i];
+
+				if (slot.Key == id)
+					return slot.Value;
+
+				if (slot.Key == 0)
+				{
+					slot.Key = id;
+					slot.Value = T();
+					m_Size++;
+					return slot.Value;
+				}
+			}
+		}
+
+		/**
+		 * @return A pointer to the value stored under the key, or nullptr if there isn't one.
+		 */
+		T* Find(UUID key)
+		{
+			return const_cast<T*>(std::as_const(*this).Find(key));
+		}
+
+		const T* Find(UUID key) const
+		{
+			uint64_t id = key;
+			if (id == 0)
+				return m_HasZeroKey ? &m_ZeroValue : nullptr;
+
+			if (m_Slots.empty())
+				return nullptr;
+
+			size_t mask = m_Slots.size() - 1;
+			for (size_t i = Hash(id); ; i = (i + 1) & mask)
+			{
+				const Slot& slot = m_Slots[i];
+
+				if (slot.Key == id)
+					return &slot.Value;
+
+				if (slot.Key == 0)
+					return nullptr;
+			}
+		}
+
+		bool Contains(UUID key) const { return Find(key) != nullptr; }
+
+		/**
+		 * @return False if there was nothing stored under the key.
+		 */
+		bool Erase(UUID key)
+		{
+			uint64_t id = key;
+			if (id == 0)
+			{
+				if (!m_HasZeroKey)
+					return false;
+
+				m_HasZeroKey = false;
+				m_ZeroValue = T();
+				m_Size--;
+				return true;
+			}
+
+			if (m_Slots.empty())
+				return false;
+
+			size_t mask = m_Slots.size() - 1;
+			size_t hole = Hash(id);
+			while (m_Slots[hole].Key != id)
+			{
+				if (m_Slots[hole].Key == 0)
+					return false;
+
+				hole = (hole + 1) & mask;
+			}
+
+			// shift back any later entries in the cluster which would no longer be reachable across the hole
+			for (size_t i = (hole + 1) & mask; m_Slots[i].Key != 0; i = (i + 1) & mask)
+			{
+				size_t home = Hash(m_Slots[i].Key);
+				bool reachable = (hole <= i) ? (hole < home && home <= i) : (hole < home || home <= i);
+				if (reachable)
+					continue;
+
+				m_Slots[hole] = std::move(m_Slots[i]);
+				hole = i;
+			}
+
+			m_Slots[hole].Key = 0;
+			m_Slots[hole].Value = T();
+			m_Size--;
+			return true;
+		}
+
+		void Clear()
+		{
+			m_Slots.clear();
+			m_Shift = 64;
+			m_HasZeroKey = false;
+			m_ZeroValue = T();
+			m_Size = 0;
+		}
+
+		/**
+		 * @brief Allocate enough slots to hold the given number of entries without rehashing.
+		 */
+		void Reserve(size_t count)
+		{
+			size_t capacity = c_MinCapacity;
+			while (count * c_MaxLoadDenominator > capacity * c_MaxLoadNumerator)
+				capacity *= 2;
+
+			if (capacity > m_Slots.size())
+				Rehash(capacity);
+		}
+
+		size_t Size() const { return m_Size; }
+		bool Empty() const { return m_Size == 0; }
+
+		/**
+		 * @brief Call func(UUID, T&) for every entry, in no particular order.
+		 */
+		template<typename Func>
+		void ForEach(Func func)
+		{
+			if (m_HasZeroKey)
+				func(UUID(0), m_ZeroValue);
+
+			for (auto& slot : m_Slots)
+			{
+				if (slot.Key != 0)
+					func(UUID(slot.Key), slot.Value);
+			}
+		}
+
+	private:
+		struct Slot
+		{
+			uint64_t Key = 0;
+			T Value = T();
+		};
+
+		static constexpr size_t c_MinCapacity = 16;
+		static constexpr size_t c_MaxLoadNumerator = 7;
+		static constexpr size_t c_MaxLoadDenominator = 8;
+
+		std::vector<Slot> m_Slots;
+		uint32_t m_Shift = 64; // 64 - log2(capacity)
+		size_t m_Size = 0;
+
+		bool m_HasZeroKey = false;
+		T m_ZeroValue = T();
+
+		// Fibonacci hashing, so that non-random (e.g. hand-assigned or sequential) ids still spread across the table
+		size_t Hash(uint64_t id) const
+		{
+			return (size_t)((id * 11400714819323198485ull) >> m_Shift);
+		}
+
+		void Rehash(size_t capacity)
+		{
+			Z_CORE_ASSERT((capacity & (capacity - 1)) == 0, "UUIDMap capacity must be a power of two");
+
+			std::vector<Slot> oldSlots(capacity);
+			oldSlots.swap(m_Slots);
+
+			m_Shift = 64;
+			for (size_t c = capacity; c > 1; c >>= 1)
+				m_Shift--;
+
+			size_t mask = capacity - 1;
+			for (auto& oldSlot : oldSlots)
+			{
+				if (oldSlot.Key == 0)
+					continue;
+
+				size_t i = Hash(oldSlot.Key);
+				while (m_Slots[i].Key != 0)
+					i = (i + 1) & mask;
+
+				m_Slots[i] = std::move(oldSlot);
+			}
+		}
+	};
+
+}
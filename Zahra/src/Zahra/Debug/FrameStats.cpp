@@ -0,0 +1,208 @@
+#include "zpch.h"
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+namespace Zahra
+{
+	using FrameStatsClock = std::chrono::steady_clock;
+	using FrameTimes = std::array<float, (size_t)FramePhase::Count>;
+
+	struct FrameStatsData
+	{
+		std::vector<FrameTimes> History;
+		uint32_t Head = 0; // slot the next frame will be written to
+		uint32_t SampleCount = 0;
+		uint64_t FramesRecorded = 0;
+
+		bool InFrame = false;
+		FrameStatsClock::time_point FrameStart;
+		FrameTimes Current{};
+		std::array<FrameStatsClock::time_point, (size_t)FramePhase::Count> PhaseStart{};
+	};
+
+	static FrameStatsData s_FrameStatsData;
+
+	namespace FrameStatsUtils
+	{
+		static float MillisecondsSince(FrameStatsClock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(FrameStatsClock::now() - start).count();
+		}
+
+		static const FrameTimes& GetFrame(uint32_t age)
+		{
+			// age 0 is the oldest recorded frame
+			uint32_t capacity = (uint32_t)s_FrameStatsData.History.size();
+			uint32_t oldest = (s_FrameStatsData.Head + capacity - s_FrameStatsData.SampleCount) % capacity;
+			return s_FrameStatsData.History[(oldest + age) % capacity];
+		}
+
+		// nearest-rank percentile of an ascending sequence
+		static float Percentile(const std::vector<float>& sorted, float percentile)
+		{
+			size_t rank = (size_t)std::ceil(percentile * sorted.size());
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		}
+	}
+
+	void FrameStats::Init(uint32_t historySize)
+	{
+		Z_CORE_ASSERT(historySize > 0, "Frame stats history must hold at least one frame");
+
+		s_FrameStatsData.History.assign(historySize, FrameTimes{});
+		Reset();
+	}
+
+	void FrameStats::Reset()
+	{
+		s_FrameStatsData.Head = 0;
+		s_FrameStatsData.SampleCount = 0;
+		s_FrameStatsData.FramesRecorded = 0;
+		s_FrameStatsData.InFrame = false;
+	}
+
+	void FrameStats::BeginFrame()
+	{
+		s_FrameStatsData.Current.fill(.0f);
+		s_FrameStatsData.FrameStart = FrameStatsClock::now();
+		s_FrameStatsData.InFrame = true;
+	}
+
+	void FrameStats::EndFrame()
+	{
+		if (!s_FrameStatsData.InFrame || s_FrameStatsData.History.empty()) return;
+
+		s_FrameStatsData.Current[(size_t)FramePhase::Total] = FrameStatsUtils::MillisecondsSince(s_FrameStatsData.FrameStart);
+		s_FrameStatsData.InFrame = false;
+
+		uint32_t capacity = (uint32_t)s_FrameStatsData.History.size();
+		s_FrameStatsData.History[s_FrameStatsData.Head] = s_FrameStatsData.Current;
+		s_FrameStatsData.Head = (s_FrameStatsData.Head + 1) % capacity;
+		s_FrameStatsData.SampleCount = std::min(s_FrameStatsData.SampleCount + 1, capacity);
+		s_FrameStatsData.FramesRecorded++;
+	}
+
+	void FrameStats::BeginPhase(FramePhase phase)
+	{
+		Z_CORE_ASSERT(phase < FramePhase::Total, "Invalid frame phase");
+
+		s_FrameStatsData.PhaseStart[(size_t)phase] = FrameStatsClock::now();
+	}
+
+	void FrameStats::EndPhase(FramePhase phase)
+	{
+		Z_CORE_ASSERT(phase < FramePhase::Total, "Invalid frame phase");
+
+		// accumulate, in case a phase is entered more than once in a frame
+		s_FrameStatsData.Current[(size_t)phase] += FrameStatsUtils::MillisecondsSince(s_FrameStatsData.PhaseStart[(size_t)phase]);
+	}
+
+	uint32_t FrameStats::GetSampleCount()
+	{
+		return s_FrameStatsData.SampleCount;
+	}
+
+	FrameTimeSummary FrameStats::GetSummary(FramePhase phase)
+	{
+		FrameTimeSummary summary;
+
+		std::vector<float> times;
+		GetHistory(phase, times);
+		if (times.empty()) return summary;
+
+		std::sort(times.begin(), times.end());
+
+		double sum = 0.0;
+		for (float time : times)
+			sum += time;
+
+		summary.SampleCount = (uint32_t)times.size();
+		summary.Mean = (float)(sum / times.size());
+		summary.P50 = FrameStatsUtils::Percentile(times, .50f);
+		summary.P95 = FrameStatsUtils::Percentile(times, .95f);
+		summary.P99 = FrameStatsUtils::Percentile(times, .99f);
+		summary.Max = times.back();
+
+		return summary;
+	}
+
+	FrameTimeHistogram FrameStats::GetHistogram(FramePhase phase, uint32_t binCount, float maxMillis)
+	{
+		Z_CORE_ASSERT(binCount > 0 && maxMillis > .0f, "Invalid histogram range");
+
+		FrameTimeHistogram histogram;
+		histogram.BinWidth = maxMillis / binCount;
+		histogram.Counts.assign(binCount, 0);
+
+		for (uint32_t i = 0; i < s_FrameStatsData.SampleCount; i++)
+		{
+			float time = FrameStatsUtils::GetFrame(i)[(size_t)phase];
+			uint32_t bin = (uint32_t)std::min(time / histogram.BinWidth, (float)(binCount - 1));
+			histogram.Counts[bin]++;
+		}
+
+		return histogram;
+	}
+
+	void FrameStats::GetHistory(FramePhase phase, std::vector<float>& times)
+	{
+		Z_CORE_ASSERT(phase < FramePhase::Count, "Invalid frame phase");
+
+		times.resize(s_FrameStatsData.SampleCount);
+		for (uint32_t i = 0; i < s_FrameStatsData.SampleCount; i++)
+			times[i] = FrameStatsUtils::GetFrame(i)[(size_t)phase];
+	}
+
+	bool FrameStats::ExportCSV(const std::filesystem::path& filepath)
+	{
+		std::ofstream stream(filepath);
+		if (!stream)
+		{
+			Z_CORE_WARN("Failed to open '{0}' for writing frame stats", filepath.string());
+			return false;
+		}
+
+		stream << "Frame";
+		for (size_t phase = 0; phase < (size_t)FramePhase::Count; phase++)
+			stream << "," << GetPhaseName((FramePhase)phase);
+		stream << "\n";
+
+		uint64_t firstFrame = s_FrameStatsData.FramesRecorded - s_FrameStatsData.SampleCount;
+		for (uint32_t i = 0; i < s_FrameStatsData.SampleCount; i++)
+		{
+			const FrameTimes& frame = FrameStatsUtils::GetFrame(i);
+
+			stream << firstFrame + i;
+			for (float time : frame)
+				stream << "," << time;
+			stream << "\n";
+		}
+
+		Z_CORE_INFO("Frame stats for {0} frames written to '{1}'", s_FrameStatsData.SampleCount, filepath.string());
+		return true;
+	}
+
+	const char* FrameStats::GetPhaseName(FramePhase phase)
+	{
+		switch (phase)
+		{
+			case FramePhase::EventPoll:		return "EventPoll";
+			case FramePhase::FixedUpdate:	return "FixedUpdate";
+			case FramePhase::LayerUpdate:	return "LayerUpdate";
+			case FramePhase::ImGui:			return "ImGui";
+			case FramePhase::EndFrame:		return "EndFrame";
+			case FramePhase::Present:		return "Present";
+			case FramePhase::Total:			return "Total";
+			default: break;
+		}
+
+		Z_CORE_ASSERT(false, "Invalid frame phase");
+		return "";
+	}
+
+}
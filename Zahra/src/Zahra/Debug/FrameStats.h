@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief The timed phases of a frame, in the order Application runs them. Phases a frame skips (e.g. everything
+	 * but EventPoll while the window is minimised, or ImGui when it is disabled) record zero for that frame.
+	 */
+	enum class FramePhase : uint8_t
+	{
+		EventPoll,
+		FixedUpdate,
+		LayerUpdate,
+		ImGui,
+		EndFrame,
+		Present,
+		Total, // wall time from the start of one frame to the start of the next
+
+		Count
+	};
+
+	/**
+	 * @brief Struct containing order statistics for one phase, over the recorded frame history. All times in milliseconds.
+	 */
+	struct FrameTimeSummary
+	{
+		uint32_t SampleCount = 0;
+		float Mean = .0f;
+		float P50 = .0f;
+		float P95 = .0f;
+		float P99 = .0f;
+		float Max = .0f;
+	};
+
+	/**
+	 * @brief Counts of recorded frames by phase time. The last bin also counts everything beyond the histogram's range.
+	 */
+	struct FrameTimeHistogram
+	{
+		float BinWidth = .0f; /**< @brief Width of each bin, in milliseconds. */
+		std::vector<uint32_t> Counts;
+	};
+
+	/**
+	 * @brief Records the CPU time spent in each phase of the last N frames, so that frame pacing can be judged by its
+	 * tail (p95/p99/max) rather than by an average, which hides the occasional long frame.
+	 *
+	 * Application drives the recording. Everything here must be called from the main thread.
+	 */
+	class FrameStats
+	{
+	public:
+		/**
+		 * @brief Set the number of frames kept in the history, discarding anything already recorded.
+		 */
+		static void Init(uint32_t historySize);
+		static void Reset();
+
+		static void BeginFrame();
+		static void EndFrame();
+
+		static void BeginPhase(FramePhase phase);
+		static void EndPhase(FramePhase phase);
+
+		/**
+		 * @brief The number of frames currently held in the history (at most the history size).
+		 */
+		static uint32_t GetSampleCount();
+
+		static FrameTimeSummary GetSummary(FramePhase phase);
+
+		/**
+		 * @param binCount Number of bins, evenly spaced from 0 to maxMillis.
+		 */
+		static FrameTimeHistogram GetHistogram(FramePhase phase, uint32_t binCount = 32, float maxMillis = 50.0f);
+
+		/**
+		 * @brief Copy the recorded times for a phase (in milliseconds) into times, oldest first.
+		 */
+		static void GetHistory(FramePhase phase, std::vector<float>& times);
+
+		/**
+		 * @brief Write the recorded history as CSV: one row per frame, one column per phase (in milliseconds).
+		 *
+		 * @return False if the file could not be opened for writing.
+		 */
+		static bool ExportCSV(const std::filesystem::path& filepath);
+
+		static const char* GetPhaseName(FramePhase phase);
+	};
+
+	/**
+	 * @brief Times a phase of the current frame, for the lifetime of the object.
+	 */
+	class FramePhaseTimer
+	{
+	public:
+		FramePhaseTimer(FramePhase phase)
+			: m_Phase(phase)
+		{
+			FrameStats::BeginPhase(m_Phase);
+		}
+
+		~FramePhaseTimer()
+		{
+			FrameStats::EndPhase(m_Phase);
+		}
+
+		FramePhaseTimer(const FramePhaseTimer&) = delete;
+		FramePhaseTimer& operator=(const FramePhaseTimer&) = delete;
+
+	private:
+		FramePhase m_Phase;
+	};
+
+}
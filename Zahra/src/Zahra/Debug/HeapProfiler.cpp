@@ -0,0 +1,364 @@
+#include "zpch.h"
+#include "HeapProfiler.h"
+
+#include "Zahra/Core/Memory.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#if defined(Z_PLATFORM_WINDOWS)
+	#include <DbgHelp.h>
+#elif defined(Z_PLATFORM_LINUX)
+	#include <execinfo.h>
+#endif
+
+namespace Zahra
+{
+	static constexpr uint32_t c_MaxStackDepth = 16;
+
+	struct HeapStackSample
+	{
+		std::atomic<uint64_t> Sequence; // index + 1 of the sample last written to this slot, 0 if never written
+
+		long long Timestamp;
+		uint64_t Frame;
+		size_t Size;
+		const char* Category;
+		uint32_t ThreadID;
+
+		uint32_t Depth;
+		void* Frames[c_MaxStackDepth];
+	};
+
+	struct HeapCounterEvent
+	{
+		long long Timestamp;
+		uint64_t Frame;
+		const char* Category; // null for the engine-wide total
+		int64_t LiveBytes;
+	};
+
+	// everything the profiler stores goes through BaseAllocator, so the profiler doesn't show up in its own stats
+	struct HeapProfilerData
+	{
+		HeapProfilerSpecification Specification;
+
+		HeapStackSample* Samples = nullptr;
+		std::atomic<uint64_t> NextSample = 0;
+
+		std::atomic<uint64_t> Frame = 0;
+
+		std::vector<HeapCounterEvent, BaseAllocator<HeapCounterEvent>> Timeline;
+		std::map<const char*, int64_t, std::less<const char*>, BaseAllocator<std::pair<const char* const, int64_t>>> LiveBytes, HighWaterMarks;
+		int64_t TotalLiveBytes = 0, TotalHighWaterMark = 0;
+
+		std::mutex Mutex;
+	};
+
+	// kept apart from the data so that they are constant-initialised, as the Allocator may query them at any time
+	static std::atomic<bool> s_HeapProfilerActive = false;
+	static std::atomic<uint32_t> s_HeapProfilerWriters = 0; // threads in OnAllocation, which EndSession waits out before freeing the samples
+	static HeapProfilerData s_HeapProfilerData;
+
+	namespace HeapProfilerUtils
+	{
+		// same clock and units as Instrumentor, so the traces line up
+		static long long GetTimestamp()
+		{
+			return Instrumentor::GetTimestamp() / 1000;
+		}
+
+		// skips the given number of innermost frames (i.e. the profiler and the Allocator themselves)
+		static uint32_t CaptureStack(void** frames, uint32_t maxFrames, uint32_t skip)
+		{
+#if defined(Z_PLATFORM_WINDOWS)
+			return (uint32_t)RtlCaptureStackBackTrace(skip, maxFrames, frames, nullptr);
+#elif defined(Z_PLATFORM_LINUX)
+			void* buffer[c_MaxStackDepth + 4];
+			skip = std::min<uint32_t>(skip, 4);
+
+			int depth = backtrace(buffer, (int)std::min<uint32_t>(maxFrames + skip, c_MaxStackDepth + 4));
+			if (depth <= (int)skip) return 0;
+
+			uint32_t count = std::min<uint32_t>((uint32_t)depth - skip, maxFrames);
+			memcpy(frames, buffer + skip, count * sizeof(void*));
+			return count;
+#else
+			return 0;
+#endif
+		}
+
+		static std::string EscapeJSON(const char* string)
+		{
+			std::string escaped;
+
+			for (const char* c = string; *c; c++)
+			{
+				switch (*c)
+				{
+					case '"':	escaped += "\\\"";	break;
+					case '\\':	escaped += "\\\\";	break;
+					default:
+						if ((unsigned char)*c >= 0x20)
+							escaped += *c;
+						break;
+				}
+			}
+
+			return escaped;
+		}
+
+		static void WriteStack(std::ofstream& stream, const HeapStackSample& sample)
+		{
+			stream << "[";
+
+#if defined(Z_PLATFORM_WINDOWS)
+			HANDLE process = GetCurrentProcess();
+
+			alignas(SYMBOL_INFO) char symbolBuffer[sizeof(SYMBOL_INFO) + 256];
+			SYMBOL_INFO* symbol = (SYMBOL_INFO*)symbolBuffer;
+
+			for (uint32_t i = 0; i < sample.Depth; i++)
+			{
+				memset(symbolBuffer, 0, sizeof(symbolBuffer));
+				symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+				symbol->MaxNameLen = 255;
+
+				if (i > 0) stream << ",";
+
+				DWORD64 displacement = 0;
+				if (SymFromAddr(process, (DWORD64)sample.Frames[i], &displacement, symbol))
+					stream << "\"" << EscapeJSON(symbol->Name) << "\"";
+				else
+					stream << "\"" << sample.Frames[i] << "\"";
+			}
+#elif defined(Z_PLATFORM_LINUX)
+			char** symbols = backtrace_symbols(sample.Frames, (int)sample.Depth);
+
+			for (uint32_t i = 0; i < sample.Depth; i++)
+			{
+				if (i > 0) stream << ",";
+
+				if (symbols)
+					stream << "\"" << EscapeJSON(symbols[i]) << "\"";
+				else
+					stream << "\"" << sample.Frames[i] << "\"";
+			}
+
+			free(symbols);
+#endif
+
+			stream << "]";
+		}
+	}
+
+	void HeapProfiler::BeginSession(const HeapProfilerSpecification& specification)
+	{
+		Z_CORE_ASSERT(!s_HeapProfilerActive, "Heap profiling session already in progress");
+
+#if !Z_TRACK_MEMORY
+		Z_CORE_WARN("Heap profiling requires Z_TRACK_MEMORY, so this session will be empty");
+#endif
+
+		std::scoped_lock<std::mutex> lock(s_HeapProfilerData.Mutex);
+
+		s_HeapProfilerData.Specification = specification;
+		if (s_HeapProfilerData.Specification.StackSampleInterval == 0)
+			s_HeapProfilerData.Specification.StackSampleInterval = 1;
+		if (s_HeapProfilerData.Specification.MaxStackSamples == 0)
+			s_HeapProfilerData.Specification.MaxStackSamples = 1;
+
+		uint32_t maxSamples = s_HeapProfilerData.Specification.MaxStackSamples;
+		s_HeapProfilerData.Samples = (HeapStackSample*)Allocator::AllocateRaw(maxSamples * sizeof(HeapStackSample));
+		for (uint32_t i = 0; i < maxSamples; i++)
+			new(&s_HeapProfilerData.Samples[i].Sequence) std::atomic<uint64_t>(0);
+
+		s_HeapProfilerData.NextSample = 0;
+		s_HeapProfilerData.Frame = 0;
+		s_HeapProfilerData.Timeline.clear();
+		s_HeapProfilerData.LiveBytes.clear();
+		s_HeapProfilerData.HighWaterMarks.clear();
+		s_HeapProfilerData.TotalLiveBytes = 0;
+		s_HeapProfilerData.TotalHighWaterMark = 0;
+
+#if defined(Z_PLATFORM_WINDOWS)
+		SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+		SymInitialize(GetCurrentProcess(), nullptr, TRUE);
+#endif
+
+		s_HeapProfilerActive = true;
+	}
+
+	void HeapProfiler::EndSession()
+	{
+		if (!s_HeapProfilerActive) return;
+
+		s_HeapProfilerActive = false;
+
+		// any allocation which saw the session still active may be writing a sample, so let those finish first
+		while (s_HeapProfilerWriters.load() != 0)
+			std::this_thread::yield();
+
+		std::scoped_lock<std::mutex> lock(s_HeapProfilerData.Mutex);
+
+		std::ofstream stream(s_HeapProfilerData.Specification.Filepath);
+
+		stream << "{\"otherData\":{\"heapHighWaterMarks\":{";
+		{
+			stream << "\"Total\":" << s_HeapProfilerData.TotalHighWaterMark;
+
+			for (auto& [category, highWaterMark] : s_HeapProfilerData.HighWaterMarks)
+				stream << ",\"" << HeapProfilerUtils::EscapeJSON(category) << "\":" << highWaterMark;
+		}
+		stream << "}},\"traceEvents\":[";
+
+		bool first = true;
+
+		for (auto& event : s_HeapProfilerData.Timeline)
+		{
+			if (!first) stream << ",";
+			first = false;
+
+			stream << "{";
+			stream << "\"cat\":\"heap\",";
+			stream << "\"name\":\"Heap: " << (event.Category ? HeapProfilerUtils::EscapeJSON(event.Category) : "Total") << "\",";
+			stream << "\"ph\":\"C\",";
+			stream << "\"pid\":0,";
+			stream << "\"ts\":" << event.Timestamp << ",";
+			stream << "\"args\":{\"live\":" << event.LiveBytes << ",\"frame\":" << event.Frame << "}";
+			stream << "}";
+		}
+
+		uint64_t sampleCount = s_HeapProfilerData.NextSample.load();
+		uint32_t maxSamples = s_HeapProfilerData.Specification.MaxStackSamples;
+		uint64_t firstSample = sampleCount > maxSamples ? sampleCount - maxSamples : 0;
+
+		for (uint64_t index = firstSample; index < sampleCount; index++)
+		{
+			const HeapStackSample& sample = s_HeapProfilerData.Samples[index % maxSamples];
+
+			// skip slots that have since been overwritten
+			if (sample.Sequence.load(std::memory_order_acquire) != index + 1)
+				continue;
+
+			if (!first) stream << ",";
+			first = false;
+
+			stream << "{";
+			stream << "\"cat\":\"heap\",";
+			stream << "\"name\":\"Allocation: " << (sample.Category ? HeapProfilerUtils::EscapeJSON(sample.Category) : "Uncategorised") << "\",";
+			stream << "\"ph\":\"i\",";
+			stream << "\"s\":\"t\",";
+			stream << "\"pid\":0,";
+			stream << "\"tid\":" << sample.ThreadID << ",";
+			stream << "\"ts\":" << sample.Timestamp << ",";
+			stream << "\"args\":{\"size\":" << sample.Size << ",\"frame\":" << sample.Frame << ",\"stack\":";
+			HeapProfilerUtils::WriteStack(stream, sample);
+			stream << "}}";
+		}
+
+		stream << "]}";
+		stream.close();
+
+#if defined(Z_PLATFORM_WINDOWS)
+		SymCleanup(GetCurrentProcess());
+#endif
+
+		free(s_HeapProfilerData.Samples);
+		s_HeapProfilerData.Samples = nullptr;
+		s_HeapProfilerData.Timeline.clear();
+
+		Z_CORE_INFO("Heap profile written to '{0}'", s_HeapProfilerData.Specification.Filepath);
+	}
+
+	bool HeapProfiler::IsActive()
+	{
+		return s_HeapProfilerActive.load(std::memory_order_relaxed);
+	}
+
+	void HeapProfiler::OnFrame()
+	{
+		if (!s_HeapProfilerActive) return;
+
+		std::scoped_lock<std::mutex> lock(s_HeapProfilerData.Mutex);
+
+		uint64_t frame = ++s_HeapProfilerData.Frame;
+		long long timestamp = HeapProfilerUtils::GetTimestamp();
+
+		// only record categories whose live bytes have changed, to keep long sessions compact
+		for (auto& [category, stats] : Allocator::GetAllocationStatsMap())
+		{
+			int64_t live = (int64_t)(stats.TotalAllocated - stats.TotalFreed);
+
+			auto [it, inserted] = s_HeapProfilerData.LiveBytes.try_emplace(category, live);
+			if (!inserted && it->second == live)
+				continue;
+
+			it->second = live;
+			s_HeapProfilerData.Timeline.push_back({ timestamp, frame, category, live });
+
+			int64_t& highWaterMark = s_HeapProfilerData.HighWaterMarks[category];
+			highWaterMark = std::max(highWaterMark, live);
+		}
+
+		AllocationStats totals = Memory::GetAllocationStats();
+		int64_t totalLive = (int64_t)(totals.TotalAllocated - totals.TotalFreed);
+
+		if (totalLive != s_HeapProfilerData.TotalLiveBytes || frame == 1)
+		{
+			s_HeapProfilerData.TotalLiveBytes = totalLive;
+			s_HeapProfilerData.Timeline.push_back({ timestamp, frame, nullptr, totalLive });
+
+			s_HeapProfilerData.TotalHighWaterMark = std::max(s_HeapProfilerData.TotalHighWaterMark, totalLive);
+		}
+	}
+
+	void HeapProfiler::OnAllocation(size_t size, const char* category)
+	{
+		if (!s_HeapProfilerActive.load(std::memory_order_relaxed)) return;
+
+		// capturing a stack may itself allocate (e.g. glibc lazily loading its unwinder)
+		thread_local bool reentered = false;
+		thread_local uint32_t countdown = 0;
+
+		if (reentered) return;
+
+		// the countdown is per thread, so only sampled allocations ever touch the shared writer count below
+		uint32_t interval = s_HeapProfilerData.Specification.StackSampleInterval;
+		if (countdown == 0 || countdown > interval)
+			countdown = interval;
+
+		if (--countdown != 0)
+			return;
+
+		// registered before checking again (both sequentially consistent, as is EndSession's side), so that either
+		// EndSession sees this writer and waits for it, or this sees the session has ended and backs off
+		s_HeapProfilerWriters.fetch_add(1);
+		if (s_HeapProfilerActive.load())
+		{
+			reentered = true;
+
+			uint64_t index = s_HeapProfilerData.NextSample.fetch_add(1, std::memory_order_relaxed);
+			HeapStackSample& sample = s_HeapProfilerData.Samples[index % s_HeapProfilerData.Specification.MaxStackSamples];
+
+			sample.Sequence.store(0, std::memory_order_relaxed);
+
+			sample.Timestamp = HeapProfilerUtils::GetTimestamp();
+			sample.Frame = s_HeapProfilerData.Frame.load(std::memory_order_relaxed);
+			sample.Size = size;
+			sample.Category = category;
+			sample.ThreadID = Instrumentor::GetThreadID();
+			sample.Depth = HeapProfilerUtils::CaptureStack(sample.Frames, c_MaxStackDepth, 2);
+
+			sample.Sequence.store(index + 1, std::memory_order_release);
+
+			reentered = false;
+		}
+
+		s_HeapProfilerWriters.fetch_sub(1, std::memory_order_release);
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Zahra
+{
+	struct HeapProfilerSpecification
+	{
+		std::string Filepath = "heap_results.json";
+
+		// capture the call stack of every Nth recorded allocation (per thread)
+		uint32_t StackSampleInterval = 64;
+
+		// maximum stored stack samples; once full, the oldest samples are overwritten
+		uint32_t MaxStackSamples = 16384;
+	};
+
+	/**
+	 * @brief Records sampled allocation call stacks, and a per-frame timeline of live bytes per allocation
+	 * category, and exports both as a Chrome trace.
+	 *
+	 * Timestamps use the same clock and process ID as Instrumentor, so the output can be loaded alongside
+	 * (or spliced into) a Z_PROFILE capture to see which frame and which subsystem caused a spike.
+	 * Requires Z_TRACK_MEMORY, since it piggybacks on the Allocator's bookkeeping.
+	 */
+	class HeapProfiler
+	{
+	public:
+		static void BeginSession(const HeapProfilerSpecification& specification = {});
+		static void EndSession();
+		static bool IsActive();
+
+		/**
+		 * @brief Snapshot per-category live bytes. Called by Application once per frame.
+		 */
+		static void OnFrame();
+
+		/**
+		 * @brief Called by the Allocator for each allocation it records, while a session is active.
+		 */
+		static void OnAllocation(size_t size, const char* category);
+	};
+
+}
+
+#if Z_TRACK_MEMORY
+	#define Z_PROFILE_HEAP_BEGIN_SESSION(filepath) { ::Zahra::HeapProfilerSpecification spec; spec.Filepath = filepath; ::Zahra::HeapProfiler::BeginSession(spec); }
+	#define Z_PROFILE_HEAP_END_SESSION() ::Zahra::HeapProfiler::EndSession()
+#else
+	#define Z_PROFILE_HEAP_BEGIN_SESSION(filepath)
+	#define Z_PROFILE_HEAP_END_SESSION()
+#endif
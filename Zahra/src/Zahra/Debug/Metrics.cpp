@@ -0,0 +1,362 @@
+#include "zpch.h"
+#include "Metrics.h"
+
+#include "Zahra/Core/Mutex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <unordered_map>
+
+namespace Zahra
+{
+	struct MetricEntry
+	{
+		std::string Name;
+		MetricType Type;
+
+		MetricCounter Counter;
+		MetricGauge Gauge;
+		Scope<MetricHistogram> Histogram;
+
+		uint64_t PreviousCount = 0; // counter value at the last snapshot
+	};
+
+	struct MetricsData
+	{
+		Mutex RegistryMutex{ "Metrics" }; // guards the registry
+		std::deque<MetricEntry> Entries; // a deque, so that references stay valid as it grows
+		std::unordered_map<std::string, MetricEntry*> Lookup;
+
+		uint32_t SnapshotInterval = 1;
+		MetricsSnapshot Latest;
+
+		std::ofstream Stream;
+		MetricsExportFormat Format = MetricsExportFormat::CSV;
+		int64_t ExportStart = 0;
+	};
+
+	static MetricsData s_MetricsData;
+
+	namespace MetricsUtils
+	{
+		static void AtomicAdd(std::atomic<double>& target, double amount)
+		{
+			double current = target.load(std::memory_order_relaxed);
+			while (!target.compare_exchange_weak(current, current + amount, std::memory_order_relaxed));
+		}
+
+		static void AtomicMax(std::atomic<double>& target, double value)
+		{
+			double current = target.load(std::memory_order_relaxed);
+			while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed));
+		}
+
+		static int64_t GetUnixTimestamp()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+		static const char* GetTypeName(MetricType type)
+		{
+			switch (type)
+			{
+				case MetricType::Counter:	return "counter";
+				case MetricType::Gauge:		return "gauge";
+				case MetricType::Histogram:	return "histogram";
+			}
+
+			return "unknown";
+		}
+
+		static MetricEntry& GetOrCreate(const std::string& name, MetricType type)
+		{
+			auto it = s_MetricsData.Lookup.find(name);
+			if (it != s_MetricsData.Lookup.end())
+			{
+				Z_CORE_ASSERT(it->second->Type == type, "Metric already registered as a different type");
+				return *it->second;
+			}
+
+			MetricEntry& entry = s_MetricsData.Entries.emplace_back();
+			entry.Name = name;
+			entry.Type = type;
+			s_MetricsData.Lookup[name] = &entry;
+
+			return entry;
+		}
+
+		// estimate from the bucket holding the nearest-rank value (the upper bound, or the max for the overflow bucket)
+		static double Percentile(const std::vector<uint64_t>& counts, const std::vector<double>& bounds, uint64_t total, double max, double percentile)
+		{
+			uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(percentile * total), 1);
+
+			uint64_t cumulative = 0;
+			for (size_t bucket = 0; bucket < bounds.size(); bucket++)
+			{
+				cumulative += counts[bucket];
+				if (cumulative >= rank)
+					return std::min(bounds[bucket], max);
+			}
+
+			return max;
+		}
+
+		static void WriteEscaped(std::ofstream& stream, const char* name)
+		{
+			// line protocol measurement names escape commas and spaces
+			for (const char* c = name; *c; c++)
+			{
+				if (*c == ',' || *c == ' ')
+					stream.put('\\');
+
+				stream.put(*c);
+			}
+		}
+
+		static void WriteCSV(const MetricsSnapshot& snapshot)
+		{
+			auto& stream = s_MetricsData.Stream;
+			double seconds = (snapshot.Timestamp - s_MetricsData.ExportStart) * 1e-9;
+
+			auto writeRow = [&](const char* name, const char* suffix, double value)
+				{
+					stream << snapshot.Frame << "," << seconds << "," << name << suffix << "," << value << "\n";
+				};
+
+			for (const auto& sample : snapshot.Samples)
+			{
+				if (sample.Type != MetricType::Histogram)
+				{
+					writeRow(sample.Name, "", sample.Value);
+					continue;
+				}
+
+				writeRow(sample.Name, ".count", sample.Value);
+				writeRow(sample.Name, ".mean", sample.Mean);
+				writeRow(sample.Name, ".p50", sample.P50);
+				writeRow(sample.Name, ".p95", sample.P95);
+				writeRow(sample.Name, ".p99", sample.P99);
+				writeRow(sample.Name, ".max", sample.Max);
+			}
+		}
+
+		static void WriteLineProtocol(const MetricsSnapshot& snapshot)
+		{
+			auto& stream = s_MetricsData.Stream;
+
+			for (const auto& sample : snapshot.Samples)
+			{
+				WriteEscaped(stream, sample.Name);
+				stream << ",type=" << GetTypeName(sample.Type) << " ";
+
+				switch (sample.Type)
+				{
+					case MetricType::Counter:
+						stream << "value=" << (uint64_t)sample.Value << "i";
+						break;
+
+					case MetricType::Gauge:
+						stream << "value=" << sample.Value;
+						break;
+
+					case MetricType::Histogram:
+						stream << "count=" << (uint64_t)sample.Value << "i,mean=" << sample.Mean << ",p50=" << sample.P50
+							<< ",p95=" << sample.P95 << ",p99=" << sample.P99 << ",max=" << sample.Max;
+						break;
+				}
+
+				stream << ",frame=" << snapshot.Frame << "i " << snapshot.Timestamp << "\n";
+			}
+		}
+	}
+
+	void MetricGauge::Add(double amount)
+	{
+		MetricsUtils::AtomicAdd(m_Value, amount);
+	}
+
+	MetricHistogram::MetricHistogram(const std::vector<double>& bounds)
+		: m_Bounds(bounds)
+	{
+		Z_CORE_ASSERT(std::is_sorted(m_Bounds.begin(), m_Bounds.end()), "Histogram bounds must be ascending");
+
+		m_Counts = CreateScope<std::atomic<uint64_t>[]>(m_Bounds.size() + 1);
+	}
+
+	void MetricHistogram::Record(double value)
+	{
+		size_t bucket = std::lower_bound(m_Bounds.begin(), m_Bounds.end(), value) - m_Bounds.begin();
+
+		m_Counts[bucket].fetch_add(1, std::memory_order_relaxed);
+		MetricsUtils::AtomicAdd(m_Sum, value);
+		MetricsUtils::AtomicMax(m_Max, value);
+	}
+
+	void MetricHistogram::TakeSnapshot(MetricSample& sample)
+	{
+		size_t bucketCount = m_Bounds.size() + 1;
+
+		std::vector<uint64_t> counts(bucketCount);
+		uint64_t total = 0;
+		for (size_t bucket = 0; bucket < bucketCount; bucket++)
+		{
+			counts[bucket] = m_Counts[bucket].exchange(0, std::memory_order_relaxed);
+			total += counts[bucket];
+		}
+
+		double sum = m_Sum.exchange(.0, std::memory_order_relaxed);
+		double max = m_Max.exchange(.0, std::memory_order_relaxed);
+
+		sample.Value = (double)total;
+		if (total == 0) return;
+
+		sample.Mean = sum / total;
+		sample.P50 = MetricsUtils::Percentile(counts, m_Bounds, total, max, .50);
+		sample.P95 = MetricsUtils::Percentile(counts, m_Bounds, total, max, .95);
+		sample.P99 = MetricsUtils::Percentile(counts, m_Bounds, total, max, .99);
+		sample.Max = max;
+	}
+
+	std::vector<double> MetricHistogram::ExponentialBounds(double start, double factor, uint32_t count)
+	{
+		std::vector<double> bounds(count);
+
+		double bound = start;
+		for (auto& b : bounds)
+		{
+			b = bound;
+			bound *= factor;
+		}
+
+		return bounds;
+	}
+
+	MetricCounter& Metrics::GetCounter(const std::string& name)
+	{
+		ScopedLock lock(s_MetricsData.RegistryMutex);
+		return MetricsUtils::GetOrCreate(name, MetricType::Counter).Counter;
+	}
+
+	MetricGauge& Metrics::GetGauge(const std::string& name)
+	{
+		ScopedLock lock(s_MetricsData.RegistryMutex);
+		return MetricsUtils::GetOrCreate(name, MetricType::Gauge).Gauge;
+	}
+
+	MetricHistogram& Metrics::GetHistogram(const std::string& name, const std::vector<double>& bounds)
+	{
+		ScopedLock lock(s_MetricsData.RegistryMutex);
+
+		MetricEntry& entry = MetricsUtils::GetOrCreate(name, MetricType::Histogram);
+		if (!entry.Histogram)
+			entry.Histogram = CreateScope<MetricHistogram>(bounds);
+
+		return *entry.Histogram;
+	}
+
+	void Metrics::SetSnapshotInterval(uint32_t frames)
+	{
+		s_MetricsData.SnapshotInterval = std::max(frames, 1u);
+	}
+
+	void Metrics::EndFrame(uint64_t frame)
+	{
+		if (frame % s_MetricsData.SnapshotInterval == 0)
+			TakeSnapshot(frame);
+	}
+
+	void Metrics::TakeSnapshot(uint64_t frame)
+	{
+		Z_PROFILE_FUNCTION();
+
+		MetricsSnapshot& snapshot = s_MetricsData.Latest;
+		snapshot.Frame = frame;
+		snapshot.Timestamp = MetricsUtils::GetUnixTimestamp();
+		snapshot.Samples.clear();
+
+		{
+			ScopedLock lock(s_MetricsData.RegistryMutex);
+
+			for (auto& entry : s_MetricsData.Entries)
+			{
+				MetricSample& sample = snapshot.Samples.emplace_back();
+				sample.Name = entry.Name.c_str();
+				sample.Type = entry.Type;
+
+				switch (entry.Type)
+				{
+					case MetricType::Counter:
+					{
+						uint64_t count = entry.Counter.GetValue();
+						sample.Value = (double)(count - entry.PreviousCount);
+						entry.PreviousCount = count;
+						break;
+					}
+
+					case MetricType::Gauge:
+					{
+						sample.Value = entry.Gauge.GetValue();
+						break;
+					}
+
+					case MetricType::Histogram:
+					{
+						entry.Histogram->TakeSnapshot(sample);
+						break;
+					}
+				}
+			}
+		}
+
+		if (!s_MetricsData.Stream.is_open()) return;
+
+		switch (s_MetricsData.Format)
+		{
+			case MetricsExportFormat::CSV:			MetricsUtils::WriteCSV(snapshot); break;
+			case MetricsExportFormat::LineProtocol:	MetricsUtils::WriteLineProtocol(snapshot); break;
+		}
+
+		s_MetricsData.Stream.flush();
+	}
+
+	const MetricsSnapshot& Metrics::GetLatestSnapshot()
+	{
+		return s_MetricsData.Latest;
+	}
+
+	bool Metrics::BeginExport(const std::filesystem::path& filepath, MetricsExportFormat format)
+	{
+		EndExport();
+
+		s_MetricsData.Stream.open(filepath);
+		if (!s_MetricsData.Stream)
+		{
+			Z_CORE_WARN("Failed to open '{0}' for writing metrics", filepath.string());
+			return false;
+		}
+
+		s_MetricsData.Format = format;
+		s_MetricsData.ExportStart = MetricsUtils::GetUnixTimestamp();
+
+		if (format == MetricsExportFormat::CSV)
+			s_MetricsData.Stream << "Frame,Time,Metric,Value\n";
+
+		Z_CORE_INFO("Streaming metrics to '{0}'", filepath.string());
+		return true;
+	}
+
+	void Metrics::EndExport()
+	{
+		if (s_MetricsData.Stream.is_open())
+			s_MetricsData.Stream.close();
+	}
+
+	bool Metrics::IsExporting()
+	{
+		return s_MetricsData.Stream.is_open();
+	}
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Zahra/Core/Scope.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Zahra
+{
+	enum class MetricType : uint8_t
+	{
+		Counter,
+		Gauge,
+		Histogram
+	};
+
+	enum class MetricsExportFormat : uint8_t
+	{
+		CSV, // one "Frame,Time,Metric,Value" row per value, so metrics registered mid-session still fit
+		LineProtocol // InfluxDB line protocol, one line per metric per snapshot
+	};
+
+	/**
+	 * @brief One metric's entry in a snapshot.
+	 */
+	struct MetricSample
+	{
+		const char* Name = nullptr;
+		MetricType Type = MetricType::Counter;
+		double Value = .0; /**< @brief Counter increase, gauge value, or histogram count. */
+
+		// histograms only
+		double Mean = .0;
+		double P50 = .0;
+		double P95 = .0;
+		double P99 = .0;
+		double Max = .0;
+	};
+
+	/**
+	 * @brief A monotonically increasing count (e.g. draw calls). Snapshots report the increase since the previous one.
+	 */
+	class MetricCounter
+	{
+	public:
+		void Increment(uint64_t amount = 1) { m_Value.fetch_add(amount, std::memory_order_relaxed); }
+		uint64_t GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<uint64_t> m_Value = 0;
+	};
+
+	/**
+	 * @brief A value which can go up and down (e.g. live entities). Snapshots report its current value.
+	 */
+	class MetricGauge
+	{
+	public:
+		void Set(double value) { m_Value.store(value, std::memory_order_relaxed); }
+		void Add(double amount);
+		double GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<double> m_Value = .0;
+	};
+
+	/**
+	 * @brief A distribution of recorded values, counted into fixed buckets. Snapshots report the count, mean, estimated
+	 * percentiles and max of the values recorded since the previous one.
+	 */
+	class MetricHistogram
+	{
+	public:
+		/**
+		 * @param bounds Ascending upper bounds of the buckets. Values beyond the last go in a final overflow bucket.
+		 */
+		MetricHistogram(const std::vector<double>& bounds);
+
+		void Record(double value);
+
+		/**
+		 * @brief Bounds growing geometrically from start, e.g. (1, 2, 4) gives 1, 2, 4, 8.
+		 */
+		static std::vector<double> ExponentialBounds(double start, double factor, uint32_t count);
+
+	private:
+		std::vector<double> m_Bounds;
+		Scope<std::atomic<uint64_t>[]> m_Counts; // one more than there are bounds
+		std::atomic<double> m_Sum = .0;
+		std::atomic<double> m_Max = .0;
+
+		// summarise and clear everything recorded so far
+		void TakeSnapshot(MetricSample& sample);
+
+		friend class Metrics;
+	};
+
+	struct MetricsSnapshot
+	{
+		uint64_t Frame = 0;
+		int64_t Timestamp = 0; /**< @brief Nanoseconds since the Unix epoch. */
+		std::vector<MetricSample> Samples; /**< @brief In order of registration. */
+	};
+
+	/**
+	 * @brief A registry of named counters, gauges and histograms, snapshotted by Application every N frames and
+	 * optionally streamed out as CSV or line protocol, e.g. for dashboards tracking a long soak test.
+	 *
+	 * Registration takes a lock, so look metrics up once and keep the reference (they live until exit):
+	 *		static MetricCounter& drawCalls = Metrics::GetCounter("renderer.draw_calls");
+	 *		drawCalls.Increment();
+	 * Updates are single relaxed atomics, and may come from any thread. Snapshots and exports are main thread only.
+	 */
+	class Metrics
+	{
+	public:
+		static MetricCounter& GetCounter(const std::string& name);
+		static MetricGauge& GetGauge(const std::string& name);
+
+		/**
+		 * @param bounds Only used if the histogram doesn't already exist.
+		 */
+		static MetricHistogram& GetHistogram(const std::string& name, const std::vector<double>& bounds = MetricHistogram::ExponentialBounds(1.0, 2.0, 16));
+
+		/**
+		 * @brief Take a snapshot every interval frames (counters and histograms then cover the whole interval).
+		 */
+		static void SetSnapshotInterval(uint32_t frames);
+
+		/**
+		 * @brief Called by Application at the end of each frame. Takes (and exports) a snapshot when one is due.
+		 */
+		static void EndFrame(uint64_t frame);
+
+		static void TakeSnapshot(uint64_t frame);
+		static const MetricsSnapshot& GetLatestSnapshot();
+
+		/**
+		 * @brief Start streaming every subsequent snapshot to a file. The output is flushed after each snapshot, so the
+		 * path may also be a named pipe (or FIFO) with a collector reading from the other end.
+		 */
+		static bool BeginExport(const std::filesystem::path& filepath, MetricsExportFormat format = MetricsExportFormat::CSV);
+		static void EndExport();
+		static bool IsExporting();
+	};
+
+}
@@ -0,0 +1,420 @@
+#include "zpch.h"
+#include "ProfilerPanel.h"
+
+#include <imgui.h>
+
+#include <cstring>
+
+namespace Zahra
+{
+	namespace ProfilerPanelUtils
+	{
+		static constexpr uint32_t c_NoNode = UINT32_MAX;
+
+		static float ToMillis(int64_t nanoseconds)
+		{
+			return (float)((double)nanoseconds * 1e-6);
+		}
+
+		// a stable colour per scope name, so the same scope is easy to follow from frame to frame
+		static ImU32 GetScopeColour(const char* name)
+		{
+			uint32_t hash = 2166136261u;
+			for (const char* c = name; *c; c++)
+				hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+			return ImColor::HSV((hash % 360) / 360.0f, .45f, .75f);
+		}
+	}
+
+	void ProfilerPanel::OnImGuiRender(bool* open)
+	{
+		if (!ImGui::Begin("Profiler", open))
+		{
+			ImGui::End();
+			return;
+		}
+
+#if !Z_PROFILING_ENABLED
+		ImGui::TextWrapped("Profiling scopes are compiled out of this build (define Z_PROFILING_ENABLED to enable them).");
+#endif
+
+		bool capturing = Instrumentor::IsLiveCaptureEnabled();
+		if (ImGui::Checkbox("Capture", &capturing))
+			Instrumentor::SetLiveCapture(capturing, (uint32_t)m_CaptureFrameCount);
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Pause", &m_Paused);
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120.0f);
+		if (ImGui::SliderInt("Frames kept", &m_CaptureFrameCount, 10, 600) && capturing)
+			Instrumentor::SetLiveCapture(true, (uint32_t)m_CaptureFrameCount);
+
+		if (capturing && !m_Paused)
+			Instrumentor::GetLiveCapture(m_Capture);
+
+		uint32_t frameCount = m_Capture.GetFrameCount();
+		if (frameCount == 0)
+		{
+			ImGui::Text("No frames captured");
+			ImGui::End();
+			return;
+		}
+
+		// frame time history, oldest first
+		std::vector<float> frameTimes(frameCount);
+		for (uint32_t i = 0; i < frameCount; i++)
+			frameTimes[i] = ProfilerPanelUtils::ToMillis(m_Capture.FrameBoundaries[i + 1] - m_Capture.FrameBoundaries[i]);
+
+		ImGui::PlotHistogram("##FrameTimes", frameTimes.data(), (int)frameCount, 0, "frame time (ms)", .0f, FLT_MAX, ImVec2(-1, 50));
+
+		m_FramesBack = std::clamp(m_FramesBack, 0, (int)frameCount - 1);
+		ImGui::SetNextItemWidth(-1);
+		ImGui::SliderInt("##FramesBack", &m_FramesBack, 0, (int)frameCount - 1, "%d frames back");
+
+		uint32_t frame = frameCount - 1 - (uint32_t)m_FramesBack;
+		BuildTree(frame, m_Tree);
+
+		if (frame > 0)
+		{
+			BuildTree(frame - 1, m_PreviousTree);
+			ImGui::Text("Frame: %.3f ms (%+.3f ms)", frameTimes[frame], frameTimes[frame] - frameTimes[frame - 1]);
+		}
+		else
+		{
+			m_PreviousTree = {};
+			ImGui::Text("Frame: %.3f ms", frameTimes[frame]);
+		}
+
+		if (ImGui::BeginTabBar("##ProfilerViews"))
+		{
+			if (ImGui::BeginTabItem("Scopes"))
+			{
+				DrawScopeTree();
+				ImGui::EndTabItem();
+			}
+
+			if (ImGui::BeginTabItem("Flame Graph"))
+			{
+				DrawFlameGraph(frame);
+				ImGui::EndTabItem();
+			}
+
+			if (ImGui::BeginTabItem("Locks"))
+			{
+				DrawLockStats();
+				ImGui::EndTabItem();
+			}
+
+			ImGui::EndTabBar();
+		}
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::BuildTree(uint32_t frame, FrameTree& tree) const
+	{
+		tree.Nodes.clear();
+		tree.Roots.clear();
+
+		int64_t frameStart = m_Capture.FrameBoundaries[frame];
+		int64_t frameEnd = m_Capture.FrameBoundaries[frame + 1];
+
+		std::vector<const ProfileCaptureRecord*> records;
+		for (auto& record : m_Capture.Records)
+		{
+			if (record.Start >= frameStart && record.Start < frameEnd)
+				records.push_back(&record);
+		}
+
+		// parents start no later than their children, and are shallower
+		std::sort(records.begin(), records.end(), [](const ProfileCaptureRecord* a, const ProfileCaptureRecord* b)
+			{
+				if (a->ThreadID != b->ThreadID) return a->ThreadID < b->ThreadID;
+				if (a->Start != b->Start) return a->Start < b->Start;
+				return a->Depth < b->Depth;
+			});
+
+		uint32_t root = ProfilerPanelUtils::c_NoNode;
+		std::vector<std::pair<uint32_t, uint32_t>> stack; // (depth, node) of the currently open scopes
+
+		for (auto record : records)
+		{
+			if (root == ProfilerPanelUtils::c_NoNode || tree.Nodes[root].ThreadID != record->ThreadID)
+			{
+				root = (uint32_t)tree.Nodes.size();
+				tree.Nodes.emplace_back().ThreadID = record->ThreadID;
+				tree.Roots.push_back(root);
+				stack.clear();
+			}
+
+			while (!stack.empty() && stack.back().first >= record->Depth)
+				stack.pop_back();
+
+			// scopes missing a parent (e.g. one which started last frame) are treated as top level
+			uint32_t parent = stack.empty() ? root : stack.back().second;
+
+			// repeated calls to the same scope from the same parent are merged
+			uint32_t node = FindChild(tree, parent, record->Name);
+			if (node == ProfilerPanelUtils::c_NoNode)
+			{
+				node = (uint32_t)tree.Nodes.size();
+
+				ScopeNode& newNode = tree.Nodes.emplace_back();
+				newNode.Name = record->Name;
+				newNode.ThreadID = record->ThreadID;
+
+				tree.Nodes[parent].Children.push_back(node);
+			}
+
+			tree.Nodes[node].Calls++;
+			tree.Nodes[node].Total += record->End - record->Start;
+
+			stack.emplace_back(record->Depth, node);
+		}
+
+		// children are always created after their parents, so a reverse sweep sees every subtree complete
+		for (size_t i = tree.Nodes.size(); i-- > 0;)
+		{
+			ScopeNode& node = tree.Nodes[i];
+
+			int64_t childTotal = 0;
+			for (uint32_t child : node.Children)
+				childTotal += tree.Nodes[child].Total;
+
+			if (!node.Name)
+				node.Total = childTotal; // thread roots
+
+			node.Self = std::max<int64_t>(node.Total - childTotal, 0);
+
+			std::sort(node.Children.begin(), node.Children.end(), [&tree](uint32_t a, uint32_t b)
+				{
+					return tree.Nodes[a].Total > tree.Nodes[b].Total;
+				});
+		}
+	}
+
+	uint32_t ProfilerPanel::FindChild(const FrameTree& tree, uint32_t parent, const char* name)
+	{
+		if (parent == ProfilerPanelUtils::c_NoNode)
+			return ProfilerPanelUtils::c_NoNode;
+
+		for (uint32_t child : tree.Nodes[parent].Children)
+		{
+			// the same scope can be recorded through different pointers (e.g. one per translation unit)
+			const char* childName = tree.Nodes[child].Name;
+			if (childName == name || std::strcmp(childName, name) == 0)
+				return child;
+		}
+
+		return ProfilerPanelUtils::c_NoNode;
+	}
+
+	void ProfilerPanel::DrawFlameGraph(uint32_t frame)
+	{
+		int64_t frameStart = m_Capture.FrameBoundaries[frame];
+		int64_t frameEnd = m_Capture.FrameBoundaries[frame + 1];
+		float frameDuration = (float)(frameEnd - frameStart);
+
+		float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		for (uint32_t root : m_Tree.Roots)
+		{
+			uint32_t threadID = m_Tree.Nodes[root].ThreadID;
+
+			uint32_t maxDepth = 0;
+			for (auto& record : m_Capture.Records)
+			{
+				if (record.ThreadID == threadID && record.Start >= frameStart && record.Start < frameEnd)
+					maxDepth = std::max(maxDepth, record.Depth);
+			}
+
+			ImGui::SeparatorText(GetThreadName(threadID));
+
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+			float height = (maxDepth + 1) * rowHeight;
+
+			ImGui::PushID((int)threadID);
+			ImGui::InvisibleButton("##Lane", ImVec2(width, height));
+			bool laneHovered = ImGui::IsItemHovered();
+			ImGui::PopID();
+
+			drawList->PushClipRect(origin, ImVec2(origin.x + width, origin.y + height), true);
+
+			for (auto& record : m_Capture.Records)
+			{
+				if (record.ThreadID != threadID || record.Start < frameStart || record.Start >= frameEnd)
+					continue;
+
+				ImVec2 min(origin.x + (record.Start - frameStart) / frameDuration * width, origin.y + record.Depth * rowHeight);
+				ImVec2 max(std::max(origin.x + (record.End - frameStart) / frameDuration * width, min.x + 1.0f), min.y + rowHeight - 1.0f);
+
+				drawList->AddRectFilled(min, max, ProfilerPanelUtils::GetScopeColour(record.Name));
+
+				if (max.x - min.x > ImGui::CalcTextSize(record.Name).x + 4.0f)
+					drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(0, 0, 0, 255), record.Name);
+
+				if (laneHovered && ImGui::IsMouseHoveringRect(min, max))
+					ImGui::SetTooltip("%s\n%.3f ms", record.Name, ProfilerPanelUtils::ToMillis(record.End - record.Start));
+			}
+
+			drawList->PopClipRect();
+		}
+	}
+
+	void ProfilerPanel::DrawScopeTree()
+	{
+		ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (!ImGui::BeginTable("##ProfilerScopes", 5, flags))
+			return;
+
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_WidthFixed, 50);
+		ImGui::TableSetupColumn("Total (ms)", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableSetupColumn("Self (ms)", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableSetupColumn("Change (ms)", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableHeadersRow();
+
+		for (uint32_t root : m_Tree.Roots)
+		{
+			int32_t previousRoot = -1;
+			for (uint32_t candidate : m_PreviousTree.Roots)
+			{
+				if (m_PreviousTree.Nodes[candidate].ThreadID == m_Tree.Nodes[root].ThreadID)
+					previousRoot = (int32_t)candidate;
+			}
+
+			DrawScopeNode(root, previousRoot);
+		}
+
+		ImGui::EndTable();
+	}
+
+	void ProfilerPanel::DrawScopeNode(uint32_t nodeIndex, int32_t previousNode)
+	{
+		const ScopeNode& node = m_Tree.Nodes[nodeIndex];
+		bool isThread = !node.Name;
+
+		ImGui::TableNextRow();
+		ImGui::TableSetColumnIndex(0);
+
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+		if (node.Children.empty())
+			flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (isThread)
+			flags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+		bool open = ImGui::TreeNodeEx((void*)(intptr_t)(nodeIndex + 1), flags, "%s", isThread ? GetThreadName(node.ThreadID) : node.Name);
+
+		if (!isThread)
+		{
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%u", node.Calls);
+		}
+
+		ImGui::TableSetColumnIndex(2);
+		ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(node.Total));
+
+		if (!isThread)
+		{
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(node.Self));
+		}
+
+		ImGui::TableSetColumnIndex(4);
+		if (previousNode >= 0)
+		{
+			float change = ProfilerPanelUtils::ToMillis(node.Total - m_PreviousTree.Nodes[previousNode].Total);
+
+			ImVec4 colour = change > .0f ? ImVec4(.95f, .45f, .4f, 1.0f) : ImVec4(.45f, .85f, .45f, 1.0f);
+			ImGui::TextColored(colour, "%+.3f", change);
+		}
+		else
+		{
+			ImGui::TextDisabled("new");
+		}
+
+		if (open && !node.Children.empty())
+		{
+			for (uint32_t child : node.Children)
+			{
+				uint32_t previousChild = FindChild(m_PreviousTree, previousNode >= 0 ? (uint32_t)previousNode : ProfilerPanelUtils::c_NoNode, m_Tree.Nodes[child].Name);
+				DrawScopeNode(child, previousChild == ProfilerPanelUtils::c_NoNode ? -1 : (int32_t)previousChild);
+			}
+
+			ImGui::TreePop();
+		}
+	}
+
+	void ProfilerPanel::DrawLockStats()
+	{
+		// totals since startup rather than per frame, as most locks are rarely contended
+		if (!m_Paused)
+			Mutex::GetLockStats(m_LockStats);
+
+		if (ImGui::Button("Reset"))
+			Mutex::ResetLockStats();
+
+		ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+		if (!ImGui::BeginTable("##ProfilerLocks", 7, flags))
+			return;
+
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Lock");
+		ImGui::TableSetupColumn("Acquisitions", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableSetupColumn("Contended", ImGuiTableColumnFlags_WidthFixed, 70);
+		ImGui::TableSetupColumn("Wait (ms)", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableSetupColumn("Max wait (ms)", ImGuiTableColumnFlags_WidthFixed, 90);
+		ImGui::TableSetupColumn("Hold (ms)", ImGuiTableColumnFlags_WidthFixed, 80);
+		ImGui::TableSetupColumn("Max hold (ms)", ImGuiTableColumnFlags_WidthFixed, 90);
+		ImGui::TableHeadersRow();
+
+		for (const LockStats& stats : m_LockStats)
+		{
+			ImGui::TableNextRow();
+
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(stats.Name);
+
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%llu", (unsigned long long)stats.Acquisitions);
+
+			ImGui::TableSetColumnIndex(2);
+			float contended = stats.Acquisitions ? 100.0f * (float)stats.Contentions / (float)stats.Acquisitions : .0f;
+			if (stats.Contentions)
+				ImGui::TextColored(ImVec4(.95f, .45f, .4f, 1.0f), "%.1f%%", contended);
+			else
+				ImGui::TextDisabled("0%%");
+
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(stats.TotalWait));
+
+			ImGui::TableSetColumnIndex(4);
+			ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(stats.MaxWait));
+
+			ImGui::TableSetColumnIndex(5);
+			ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(stats.TotalHold));
+
+			ImGui::TableSetColumnIndex(6);
+			ImGui::Text("%.3f", ProfilerPanelUtils::ToMillis(stats.MaxHold));
+		}
+
+		ImGui::EndTable();
+	}
+
+	const char* ProfilerPanel::GetThreadName(uint32_t threadID) const
+	{
+		for (auto& [id, name] : m_Capture.Threads)
+		{
+			if (id == threadID && !name.empty())
+				return name.c_str();
+		}
+
+		return "Unnamed thread";
+	}
+
+}
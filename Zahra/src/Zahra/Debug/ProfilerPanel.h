@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Debug/Profiling.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief An ImGui window showing a live capture of the last few frames' Z_PROFILE_SCOPE timings, as a flame graph
+	 * (one lane per thread) and as a scope tree with call counts, total and self times, and the change in total time
+	 * since the previous frame, plus a table of lock contention totals for each named Mutex.
+	 *
+	 * Live capture is started by the window's own checkbox (so costs nothing until asked for), and only has anything
+	 * to show in builds with Z_PROFILING_ENABLED.
+	 */
+	class ProfilerPanel
+	{
+	public:
+		/**
+		 * @param open If given, the window gets a close button which sets this to false.
+		 */
+		void OnImGuiRender(bool* open = nullptr);
+
+	private:
+		struct ScopeNode
+		{
+			const char* Name = nullptr;
+			uint32_t ThreadID = 0;
+			uint32_t Calls = 0;
+			int64_t Total = 0;
+			int64_t Self = 0;
+			std::vector<uint32_t> Children;
+		};
+
+		struct FrameTree
+		{
+			std::vector<ScopeNode> Nodes;
+			std::vector<uint32_t> Roots; // one per thread
+		};
+
+		ProfileCapture m_Capture;
+		FrameTree m_Tree, m_PreviousTree;
+		std::vector<LockStats> m_LockStats;
+
+		bool m_Paused = false;
+		int m_FramesBack = 0; // 0 for the latest captured frame
+		int m_CaptureFrameCount = 120;
+
+		void BuildTree(uint32_t frame, FrameTree& tree) const;
+		static uint32_t FindChild(const FrameTree& tree, uint32_t parent, const char* name);
+
+		void DrawFlameGraph(uint32_t frame);
+		void DrawScopeTree();
+		void DrawScopeNode(uint32_t node, int32_t previousNode);
+		void DrawLockStats();
+
+		const char* GetThreadName(uint32_t threadID) const;
+	};
+
+}
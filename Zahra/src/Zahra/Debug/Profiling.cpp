@@ -0,0 +1,458 @@
+#include "zpch.h"
+#include "Profiling.h"
+
+#include "Zahra/Core/Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+
+namespace Zahra
+{
+	// single-producer (the owning thread), single-consumer (whoever holds BufferMutex) ring of completed scopes
+	struct ProfileThreadBuffer
+	{
+		static constexpr uint64_t Capacity = 1 << 14; // a power of two
+
+		std::unique_ptr<ProfileRecord[]> Records = std::make_unique<ProfileRecord[]>(Capacity);
+
+		alignas(64) std::atomic<uint64_t> Head = 0; // next record to be written
+		alignas(64) std::atomic<uint64_t> Tail = 0; // next record to be read
+		std::atomic<uint64_t> Dropped = 0;
+
+		uint32_t ThreadID = 0;
+		std::string ThreadName; // guarded by InstrumentorData::BufferMutex
+	};
+
+	struct InstrumentorData
+	{
+		std::mutex BufferMutex; // held by whichever thread is draining the buffers
+		std::vector<Scope<ProfileThreadBuffer>> Buffers; // never shrinks, as threads hold on to their buffer
+
+		// session output (guarded by BufferMutex)
+		bool SessionOpen = false;
+		std::string SessionName;
+		std::ofstream Stream;
+		bool FirstEvent = true;
+		uint64_t RecordsWritten = 0;
+		uint64_t DroppedAtSessionStart = 0;
+
+		// live capture (guarded by LiveMutex)
+		std::mutex LiveMutex;
+		bool LiveCapture = false;
+		uint32_t LiveFrameCount = 0;
+		std::deque<int64_t> LiveFrameBoundaries;
+		std::deque<ProfileCaptureRecord> LiveRecords;
+		int64_t LiveCollectedUntil = 0; // every scope ending before this has been drained
+
+		// GPU lane (written only by the render thread)
+		ProfileThreadBuffer* GPUBuffer = nullptr;
+		std::atomic<int64_t> GPUCollectedUntil = 0;
+		std::atomic<int64_t> GPUMarkedAt = 0;
+
+		Scope<Thread> Writer;
+		std::mutex WriterMutex;
+		std::condition_variable WriterCondition;
+		bool WriterRunning = false;
+
+		~InstrumentorData()
+		{
+			// a live capture may still be running at exit
+			if (Writer)
+			{
+				{
+					std::scoped_lock<std::mutex> lock(WriterMutex);
+					WriterRunning = false;
+					WriterCondition.notify_all();
+				}
+
+				Writer->Join();
+			}
+		}
+	};
+
+	// kept apart from the data so that it is constant-initialised, as scopes may be recorded at any time
+	static std::atomic<bool> s_InstrumentorActive = false; // is a session or live capture running?
+	static std::atomic<uint32_t> s_NextThreadID = 0;
+	static InstrumentorData s_InstrumentorData;
+
+	static thread_local ProfileThreadBuffer* t_ProfileBuffer = nullptr;
+
+	namespace InstrumentorUtils
+	{
+		static constexpr auto c_WriterInterval = std::chrono::milliseconds(5);
+
+		// allowance for a scope which has taken its end timestamp, but not yet been pushed, when the buffers are drained
+		static constexpr int64_t c_CollectionMargin = 1000000;
+
+		// if the GPU lane hasn't been marked for this long, assume nothing more is coming and stop holding back frames
+		static constexpr int64_t c_GPUMarkTimeout = 250000000;
+
+		static ProfileThreadBuffer& GetThreadBuffer()
+		{
+			if (!t_ProfileBuffer)
+			{
+				std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+				auto& buffer = s_InstrumentorData.Buffers.emplace_back(CreateScope<ProfileThreadBuffer>());
+				buffer->ThreadID = Instrumentor::GetThreadID();
+				t_ProfileBuffer = buffer.get();
+			}
+
+			return *t_ProfileBuffer;
+		}
+
+		static ProfileThreadBuffer& GetGPUBuffer()
+		{
+			if (!s_InstrumentorData.GPUBuffer)
+			{
+				std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+				auto& buffer = s_InstrumentorData.Buffers.emplace_back(CreateScope<ProfileThreadBuffer>());
+				buffer->ThreadID = s_NextThreadID.fetch_add(1, std::memory_order_relaxed);
+				buffer->ThreadName = "GPU";
+				s_InstrumentorData.GPUBuffer = buffer.get();
+			}
+
+			return *s_InstrumentorData.GPUBuffer;
+		}
+
+		static void PushRecord(ProfileThreadBuffer& buffer, const ProfileRecord& record)
+		{
+			uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+			if (head - buffer.Tail.load(std::memory_order_acquire) >= ProfileThreadBuffer::Capacity)
+			{
+				buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			buffer.Records[head & (ProfileThreadBuffer::Capacity - 1)] = record;
+			buffer.Head.store(head + 1, std::memory_order_release);
+		}
+
+		static void WriteEscaped(std::ofstream& stream, const char* string)
+		{
+			for (const char* c = string; *c; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					stream.put('\\');
+
+				stream.put(*c);
+			}
+		}
+
+		static void WriteTimestamp(std::ofstream& stream, int64_t nanoseconds)
+		{
+			// Chrome traces are in microseconds, but accept fractions
+			char text[32];
+			snprintf(text, sizeof(text), "%lld.%03lld", (long long)(nanoseconds / 1000), (long long)(nanoseconds % 1000));
+			stream << text;
+		}
+
+		static void WriteRecord(const ProfileRecord& record, uint32_t threadID)
+		{
+			auto& stream = s_InstrumentorData.Stream;
+
+			if (!s_InstrumentorData.FirstEvent)
+				stream << ",";
+			s_InstrumentorData.FirstEvent = false;
+
+			stream << "{\"cat\":\"function\",\"dur\":";
+			WriteTimestamp(stream, record.End - record.Start);
+			stream << ",\"name\":\"";
+			WriteEscaped(stream, record.Name);
+			stream << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadID << ",\"ts\":";
+			WriteTimestamp(stream, record.Start);
+			stream << "}";
+
+			s_InstrumentorData.RecordsWritten++;
+		}
+
+		// hand everything recorded so far to the session and/or live capture (BufferMutex must be held)
+		static void DrainLocked()
+		{
+			int64_t drainStart = Instrumentor::GetTimestamp();
+			int64_t collectedUntil = drainStart - c_CollectionMargin;
+
+			// read before draining, so that the GPU records it covers have already been pushed
+			int64_t gpuCollectedUntil = s_InstrumentorData.GPUCollectedUntil.load(std::memory_order_acquire);
+			if (drainStart - s_InstrumentorData.GPUMarkedAt.load(std::memory_order_relaxed) < c_GPUMarkTimeout)
+				collectedUntil = std::min(collectedUntil, gpuCollectedUntil);
+
+			std::scoped_lock<std::mutex> liveLock(s_InstrumentorData.LiveMutex);
+			bool live = s_InstrumentorData.LiveCapture;
+
+			for (auto& buffer : s_InstrumentorData.Buffers)
+			{
+				uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+				uint64_t head = buffer->Head.load(std::memory_order_acquire);
+
+				for (uint64_t i = tail; i < head; i++)
+				{
+					const ProfileRecord& record = buffer->Records[i & (ProfileThreadBuffer::Capacity - 1)];
+
+					if (s_InstrumentorData.SessionOpen)
+						WriteRecord(record, buffer->ThreadID);
+
+					if (live)
+						s_InstrumentorData.LiveRecords.push_back({ record.Name, record.Start, record.End, record.Depth, buffer->ThreadID });
+				}
+
+				buffer->Tail.store(head, std::memory_order_release);
+			}
+
+			if (live)
+				s_InstrumentorData.LiveCollectedUntil = std::max(s_InstrumentorData.LiveCollectedUntil, collectedUntil);
+		}
+
+		static void Drain()
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+			DrainLocked();
+		}
+
+		static void WriterLoop()
+		{
+			std::unique_lock<std::mutex> lock(s_InstrumentorData.WriterMutex);
+
+			while (s_InstrumentorData.WriterRunning)
+			{
+				s_InstrumentorData.WriterCondition.wait_for(lock, c_WriterInterval);
+
+				lock.unlock();
+				Drain();
+				lock.lock();
+			}
+		}
+
+		static void UpdateWriter()
+		{
+			bool needed = s_InstrumentorData.SessionOpen || s_InstrumentorData.LiveCapture;
+			s_InstrumentorActive = needed;
+
+			if (needed && !s_InstrumentorData.Writer)
+			{
+				s_InstrumentorData.WriterRunning = true;
+				s_InstrumentorData.Writer = CreateScope<Thread>("Profiler Writer");
+				s_InstrumentorData.Writer->Dispatch(WriterLoop);
+			}
+			else if (!needed && s_InstrumentorData.Writer)
+			{
+				{
+					std::scoped_lock<std::mutex> lock(s_InstrumentorData.WriterMutex);
+					s_InstrumentorData.WriterRunning = false;
+					s_InstrumentorData.WriterCondition.notify_all();
+				}
+
+				s_InstrumentorData.Writer->Join();
+				s_InstrumentorData.Writer.reset();
+			}
+		}
+
+		static uint64_t CountDropped()
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+			uint64_t dropped = 0;
+			for (auto& buffer : s_InstrumentorData.Buffers)
+				dropped += buffer->Dropped.load(std::memory_order_relaxed);
+
+			return dropped;
+		}
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		if (s_InstrumentorData.SessionOpen)
+			EndSession();
+
+		uint64_t dropped = InstrumentorUtils::CountDropped();
+
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+			// anything recorded before the session belongs to the live capture (if any), not the file
+			InstrumentorUtils::DrainLocked();
+
+			s_InstrumentorData.Stream.open(filepath);
+			s_InstrumentorData.Stream << "{\"otherData\": {},\"traceEvents\":[";
+			s_InstrumentorData.SessionName = name;
+			s_InstrumentorData.FirstEvent = true;
+			s_InstrumentorData.RecordsWritten = 0;
+			s_InstrumentorData.DroppedAtSessionStart = dropped;
+			s_InstrumentorData.SessionOpen = true;
+		}
+
+		InstrumentorUtils::UpdateWriter();
+	}
+
+	void Instrumentor::EndSession()
+	{
+		if (!s_InstrumentorData.SessionOpen) return;
+
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+			InstrumentorUtils::DrainLocked();
+
+			auto& stream = s_InstrumentorData.Stream;
+			for (auto& buffer : s_InstrumentorData.Buffers)
+			{
+				if (buffer->ThreadName.empty())
+					continue;
+
+				if (!s_InstrumentorData.FirstEvent)
+					stream << ",";
+				s_InstrumentorData.FirstEvent = false;
+
+				stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->ThreadID << ",\"args\":{\"name\":\"";
+				InstrumentorUtils::WriteEscaped(stream, buffer->ThreadName.c_str());
+				stream << "\"}}";
+			}
+
+			stream << "]}";
+			stream.close();
+
+			s_InstrumentorData.SessionOpen = false;
+		}
+
+		InstrumentorUtils::UpdateWriter();
+
+		uint64_t dropped = InstrumentorUtils::CountDropped() - s_InstrumentorData.DroppedAtSessionStart;
+		if (dropped > 0)
+			Z_CORE_WARN("Profiling session '{0}' dropped {1} scopes (ring buffers full)", s_InstrumentorData.SessionName, dropped);
+	}
+
+	bool Instrumentor::IsActive()
+	{
+		return s_InstrumentorData.SessionOpen;
+	}
+
+	void Instrumentor::SetLiveCapture(bool enabled, uint32_t frameCount)
+	{
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.LiveMutex);
+
+			s_InstrumentorData.LiveFrameCount = frameCount;
+
+			if (enabled == s_InstrumentorData.LiveCapture)
+				return;
+
+			s_InstrumentorData.LiveCapture = enabled;
+			s_InstrumentorData.LiveFrameBoundaries.clear();
+			s_InstrumentorData.LiveRecords.clear();
+			s_InstrumentorData.LiveCollectedUntil = 0;
+		}
+
+		InstrumentorUtils::UpdateWriter();
+	}
+
+	bool Instrumentor::IsLiveCaptureEnabled()
+	{
+		return s_InstrumentorData.LiveCapture;
+	}
+
+	void Instrumentor::MarkFrame()
+	{
+		std::scoped_lock<std::mutex> lock(s_InstrumentorData.LiveMutex);
+
+		if (!s_InstrumentorData.LiveCapture) return;
+
+		auto& boundaries = s_InstrumentorData.LiveFrameBoundaries;
+		auto& records = s_InstrumentorData.LiveRecords;
+
+		boundaries.push_back(GetTimestamp());
+
+		// retain a frame more than requested, as the newest may not have been fully collected yet
+		while (boundaries.size() > s_InstrumentorData.LiveFrameCount + 2)
+			boundaries.pop_front();
+
+		// records arrive roughly in end order, so trimming from the front is a good approximation
+		while (!records.empty() && records.front().End < boundaries.front())
+			records.pop_front();
+	}
+
+	void Instrumentor::GetLiveCapture(ProfileCapture& capture)
+	{
+		capture.FrameBoundaries.clear();
+		capture.Records.clear();
+		capture.Threads.clear();
+
+		{
+			std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+
+			for (auto& buffer : s_InstrumentorData.Buffers)
+				capture.Threads.emplace_back(buffer->ThreadID, buffer->ThreadName);
+		}
+
+		std::scoped_lock<std::mutex> lock(s_InstrumentorData.LiveMutex);
+
+		const auto& boundaries = s_InstrumentorData.LiveFrameBoundaries;
+
+		size_t complete = 0;
+		while (complete < boundaries.size() && boundaries[complete] <= s_InstrumentorData.LiveCollectedUntil)
+			complete++;
+
+		if (complete < 2) return;
+
+		size_t first = complete > s_InstrumentorData.LiveFrameCount + 1 ? complete - s_InstrumentorData.LiveFrameCount - 1 : 0;
+		capture.FrameBoundaries.assign(boundaries.begin() + first, boundaries.begin() + complete);
+
+		int64_t start = capture.FrameBoundaries.front();
+		int64_t end = capture.FrameBoundaries.back();
+
+		for (auto& record : s_InstrumentorData.LiveRecords)
+		{
+			if (record.Start >= start && record.Start < end)
+				capture.Records.push_back(record);
+		}
+	}
+
+	void Instrumentor::WriteProfile(const ProfileRecord& record)
+	{
+		if (!s_InstrumentorActive.load(std::memory_order_relaxed)) return;
+
+		InstrumentorUtils::PushRecord(InstrumentorUtils::GetThreadBuffer(), record);
+	}
+
+	void Instrumentor::WriteGPUProfile(const ProfileRecord& record)
+	{
+		if (!s_InstrumentorActive.load(std::memory_order_relaxed)) return;
+
+		InstrumentorUtils::PushRecord(InstrumentorUtils::GetGPUBuffer(), record);
+	}
+
+	void Instrumentor::MarkGPUCollected(int64_t timestamp)
+	{
+		s_InstrumentorData.GPUMarkedAt.store(GetTimestamp(), std::memory_order_relaxed);
+		s_InstrumentorData.GPUCollectedUntil.store(timestamp, std::memory_order_release);
+	}
+
+	void Instrumentor::SetThreadName(const std::string& name)
+	{
+		ProfileThreadBuffer& buffer = InstrumentorUtils::GetThreadBuffer();
+
+		std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+		buffer.ThreadName = name;
+	}
+
+	uint32_t Instrumentor::GetThreadID()
+	{
+		static thread_local uint32_t threadID = s_NextThreadID.fetch_add(1, std::memory_order_relaxed);
+		return threadID;
+	}
+
+	InstrumentorStats Instrumentor::GetStats()
+	{
+		InstrumentorStats stats;
+		stats.RecordsDropped = InstrumentorUtils::CountDropped() - s_InstrumentorData.DroppedAtSessionStart;
+
+		std::scoped_lock<std::mutex> lock(s_InstrumentorData.BufferMutex);
+		stats.RecordsWritten = s_InstrumentorData.RecordsWritten;
+		stats.ThreadCount = (uint32_t)s_InstrumentorData.Buffers.size();
+
+		return stats;
+	}
+
+}
@@ -3,103 +3,147 @@
 #include "Zahra/Core/Scope.h"
 
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace Zahra
 {
-	struct ProfileResult
+	/**
+	 * @brief A single completed profiling scope, as stored in the per-thread ring buffers.
+	 */
+	struct ProfileRecord
+	{
+		const char* Name; // must outlive the session (e.g. a string literal or function signature)
+		int64_t Start; // steady_clock nanoseconds
+		int64_t End;
+		uint32_t Depth; // nesting depth on the recording thread, 0 for outermost scopes
+	};
+
+	/**
+	 * @brief A profiling scope as held in a live capture, tagged with the thread that recorded it.
+	 */
+	struct ProfileCaptureRecord
 	{
 		const char* Name;
-		long long  Start, End;
+		int64_t Start;
+		int64_t End;
+		uint32_t Depth;
 		uint32_t ThreadID;
 	};
 
-
-	struct InstrumentationSession
+	/**
+	 * @brief A copy of the most recent complete frames of a live capture.
+	 */
+	struct ProfileCapture
 	{
-		std::string Name;
+		std::vector<int64_t> FrameBoundaries; // frame i runs from FrameBoundaries[i] to FrameBoundaries[i + 1]
+		std::vector<ProfileCaptureRecord> Records; // every scope starting within those frames, in no particular order
+		std::vector<std::pair<uint32_t, std::string>> Threads; // ID and name of each thread that has recorded anything
+
+		uint32_t GetFrameCount() const { return FrameBoundaries.empty() ? 0 : (uint32_t)FrameBoundaries.size() - 1; }
 	};
 
+	/**
+	 * @brief Struct containing counts of records passing through the Instrumentor in the current (or last) session.
+	 */
+	struct InstrumentorStats
+	{
+		uint64_t RecordsWritten = 0; /**< @brief Records converted and written to the trace file so far. */
+		uint64_t RecordsDropped = 0; /**< @brief Records discarded because their thread's ring buffer was full. */
+		uint32_t ThreadCount = 0; /**< @brief Number of threads that have recorded anything since startup. */
+	};
 
+	/**
+	 * @brief Collects Z_PROFILE_SCOPE timings and writes them out as a Chrome trace.
+	 *
+	 * Each thread writes fixed-size binary records into its own lock-free ring buffer, so recording a scope costs two
+	 * clock reads and a couple of stores, with no locks, formatting or I/O. A background thread periodically drains
+	 * every buffer, converting the records to JSON. If a thread outpaces it, new records are dropped (and counted)
+	 * rather than blocking the thread.
+	 *
+	 * Independently of any session, a live capture can keep the records of the last few frames in memory, for
+	 * in-engine display (see ProfilerPanel).
+	 */
 	class Instrumentor
 	{
 	public:
-		Instrumentor()
-			: m_CurrentSession(nullptr), m_ProfileCount(0)
-		{}
-
-		void BeginSession(const std::string& name, const std::string& filepath = "results.json")
+		static void BeginSession(const std::string& name, const std::string& filepath = "results.json");
+		static void EndSession();
+		static bool IsActive();
+
+		/**
+		 * @brief Start or stop keeping the records of recent frames in memory.
+		 *
+		 * @param frameCount Number of complete frames to retain.
+		 */
+		static void SetLiveCapture(bool enabled, uint32_t frameCount = 120);
+		static bool IsLiveCaptureEnabled();
+
+		/**
+		 * @brief Mark the start of a new frame, for live captures. Called by Application at the top of each frame.
+		 */
+		static void MarkFrame();
+
+		/**
+		 * @brief Copy the retained frames of the live capture (only those which have been fully collected).
+		 */
+		static void GetLiveCapture(ProfileCapture& capture);
+
+		/**
+		 * @brief Queue a completed scope on the calling thread's buffer (a no-op outside of a session).
+		 */
+		static void WriteProfile(const ProfileRecord& record);
+
+		/**
+		 * @brief Queue a completed scope on the "GPU" lane, with its times already converted to steady_clock
+		 * nanoseconds. Only to be called from the render thread.
+		 */
+		static void WriteGPUProfile(const ProfileRecord& record);
+
+		/**
+		 * @brief Declare that every GPU scope starting before the given time has been written, so that live captures
+		 * can include frames up to that point (GPU results arrive a few frames late). Only to be called from the
+		 * render thread.
+		 */
+		static void MarkGPUCollected(int64_t timestamp);
+
+		/**
+		 * @brief Label the calling thread in subsequent traces.
+		 */
+		static void SetThreadName(const std::string& name);
+
+		/**
+		 * @brief A small, stable ID for the calling thread (its "tid" in traces).
+		 */
+		static uint32_t GetThreadID();
+
+		static InstrumentorStats GetStats();
+
+		static int64_t GetTimestamp()
 		{
-			m_OutputStream.open(filepath);
-			WriteHeader();
-			m_CurrentSession = CreateScope<InstrumentationSession>();
-			m_CurrentSession->Name = name;
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 		}
-
-		void EndSession()
-		{
-			WriteFooter();
-			m_OutputStream.close();
-			m_CurrentSession.reset();
-			m_ProfileCount = 0;
-		}
-
-		void WriteProfile(const ProfileResult& result)
-		{
-			if (m_ProfileCount++ > 0)
-				m_OutputStream << ",";
-
-			std::string name = result.Name;
-			std::replace(name.begin(), name.end(), '"', '\'');
-
-			m_OutputStream << "{";
-			m_OutputStream << "\"cat\":\"function\",";
-			m_OutputStream << "\"dur\":" << (result.End - result.Start) << ",";
-			m_OutputStream << "\"name\":\"" << name << "\",";
-			m_OutputStream << "\"ph\":\"X\",";
-			m_OutputStream << "\"pid\":0,";
-			m_OutputStream << "\"tid\":" << result.ThreadID << ",";
-			m_OutputStream << "\"ts\":" << result.Start;
-			m_OutputStream << "}";
-
-			m_OutputStream.flush();
-		}
-
-		void WriteHeader()
-		{
-			m_OutputStream << "{\"otherData\": {}, \"traceEvents\":[";
-			m_OutputStream.flush();
-		}
-
-		void WriteFooter()
-		{
-			m_OutputStream << "]}";
-			m_OutputStream.flush();
-		}
-
-		 static Instrumentor& Get()
-		{
-			static Instrumentor instance;
-			return instance;
-		}
-
-	private:
-		Scope<InstrumentationSession> m_CurrentSession;
-		std::ofstream m_OutputStream;
-		int m_ProfileCount;
-
 	};
 
+	namespace ProfilingUtils
+	{
+		// current scope nesting depth on this thread
+		inline thread_local uint32_t t_ScopeDepth = 0;
+	}
+
 	class InstrumentationTimer
 	{
 	public:
 		InstrumentationTimer(const char* name)
-			: m_Name(name), m_Stopped(false)
+			: m_Name(name), m_Depth(ProfilingUtils::t_ScopeDepth++)
 		{
-			m_StartTimepoint = std::chrono::high_resolution_clock::now();
+			m_Start = Instrumentor::GetTimestamp();
 		}
 
 		~InstrumentationTimer()
@@ -112,21 +156,19 @@ namespace Zahra
 
 		void Stop()
 		{
-			auto endTimepoint = std::chrono::high_resolution_clock::now();
-
-			long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch().count();
-			long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
+			int64_t end = Instrumentor::GetTimestamp();
 
-			size_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-			Instrumentor::Get().WriteProfile({ m_Name, start, end });
+			Instrumentor::WriteProfile({ m_Name, m_Start, end, m_Depth });
 
+			ProfilingUtils::t_ScopeDepth--;
 			m_Stopped = true;
 		}
 
 	private:
 		const char* m_Name;
-		std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
-		bool m_Stopped;
+		int64_t m_Start;
+		uint32_t m_Depth;
+		bool m_Stopped = false;
 
 	};
 
@@ -154,13 +196,17 @@ namespace Zahra
 	#define Z_FUNC_SIG "Z_FUNC_SIG unknown!"
 	#endif
 
-	#define Z_PROFILE_BEGIN_SESSION(name, filepath) ::Zahra::Instrumentor::Get().BeginSession(name, filepath)
-	#define Z_PROFILE_END_SESSION() ::Zahra::Instrumentor::Get().EndSession()
+	#define Z_PROFILE_BEGIN_SESSION(name, filepath) ::Zahra::Instrumentor::BeginSession(name, filepath)
+	#define Z_PROFILE_END_SESSION() ::Zahra::Instrumentor::EndSession()
+	#define Z_PROFILE_THREAD(name) ::Zahra::Instrumentor::SetThreadName(name)
+	#define Z_PROFILE_FRAME() ::Zahra::Instrumentor::MarkFrame()
 	#define Z_PROFILE_SCOPE(name) ::Zahra::InstrumentationTimer timer##__LINE__(name)
 	#define Z_PROFILE_FUNCTION() Z_PROFILE_SCOPE(Z_FUNC_SIG)
 #else
 	#define Z_PROFILE_BEGIN_SESSION(name, filepath)
 	#define Z_PROFILE_END_SESSION()
+	#define Z_PROFILE_THREAD(name)
+	#define Z_PROFILE_FRAME()
 	#define Z_PROFILE_SCOPE(name)
 	#define Z_PROFILE_FUNCTION()
 #endif
@@ -6,8 +6,8 @@
 namespace Zahra
 {
 
-	// Right now events will interrupt everything else while being handled,
-	// but later we will implement an event queue to be checked each frame.
+	// Events from the OS are buffered in an EventQueue as they arrive, then
+	// dispatched together at a fixed point in each frame (see Application::Run).
 
 	enum class EventType
 	{
@@ -30,7 +30,9 @@ namespace Zahra
 
 #define EVENT_CLASS_TYPE(type)	static EventType GetStaticType() { return EventType::type; }\
 								virtual EventType GetEventType() const override { return GetStaticType(); }\
-								virtual const char* GetName() const override { return #type; }
+								virtual const char* GetName() const override { return #type; }\
+								virtual size_t GetSize() const override { return sizeof(*this); }\
+								virtual Event* CopyTo(void* location) const override { return new(location) std::decay_t<decltype(*this)>(*this); }
 
 #define EVENT_CLASS_CATEGORY(category) virtual int GetCategoryFlags() const override { return category; }
 
@@ -48,6 +50,10 @@ namespace Zahra
 		virtual int GetCategoryFlags() const = 0;
 		virtual std::string ToString() const { return GetName(); }
 
+		// for EventQueue, which stores copies of events of any type
+		virtual size_t GetSize() const = 0;
+		virtual Event* CopyTo(void* location) const = 0; // location must be at least GetSize() bytes, with max_align_t alignment
+
 		bool IsInCategory(EventCategory category)
 		{
 			return GetCategoryFlags() & category;
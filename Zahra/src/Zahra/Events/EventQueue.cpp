@@ -0,0 +1,113 @@
+#include "zpch.h"
+#include "EventQueue.h"
+
+#include "Zahra/Core/Memory.h"
+
+namespace Zahra
+{
+	static constexpr const char* s_EventQueueCategory = "EventQueue";
+
+	namespace EventQueueUtils
+	{
+		// events for which only the latest value matters
+		static bool IsCoalescable(EventType type)
+		{
+			switch (type)
+			{
+				case EventType::MouseMoved:
+				case EventType::WindowResize:
+				case EventType::WindowMoved:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		static uint64_t AlignUp(uint64_t size)
+		{
+			constexpr uint64_t alignment = alignof(std::max_align_t);
+			return (size + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	EventQueue::EventQueue(uint64_t arenaSize)
+		: m_ArenaSize(arenaSize)
+	{
+		m_Arena = (byte*)Allocator::Allocate(m_ArenaSize, s_EventQueueCategory);
+		m_Events.reserve(256);
+	}
+
+	EventQueue::~EventQueue()
+	{
+		Clear();
+		Allocator::Free(m_Arena);
+	}
+
+	void EventQueue::Push(const Event& event)
+	{
+		m_Stats.EventsQueued++;
+
+		EventType type = event.GetEventType();
+
+		if (m_Events.size() > m_NextToDispatch && EventQueueUtils::IsCoalescable(type))
+		{
+			QueuedEvent& previous = m_Events.back();
+			if (previous.Data->GetEventType() == type)
+			{
+				// same type, so the same size: copy over it in place
+				previous.Data->~Event();
+				previous.Data = event.CopyTo(previous.Data);
+
+				m_Stats.EventsCoalesced++;
+				return;
+			}
+		}
+
+		QueuedEvent& queued = m_Events.emplace_back();
+
+		uint64_t size = EventQueueUtils::AlignUp(event.GetSize());
+		if (m_ArenaOffset + size <= m_ArenaSize)
+		{
+			queued.Data = event.CopyTo(m_Arena + m_ArenaOffset);
+			m_ArenaOffset += size;
+		}
+		else
+		{
+			queued.Data = event.CopyTo(Allocator::Allocate(size, s_EventQueueCategory));
+			queued.OnHeap = true;
+			m_Stats.OverflowCount++;
+		}
+	}
+
+	void EventQueue::Dispatch(const EventHandlerFn& handler)
+	{
+		Z_PROFILE_FUNCTION();
+
+		// indexed, since handlers may push more events
+		while (m_NextToDispatch < m_Events.size())
+		{
+			Event* event = m_Events[m_NextToDispatch++].Data;
+			handler(*event);
+			m_Stats.EventsDispatched++;
+		}
+
+		Clear();
+	}
+
+	void EventQueue::Clear()
+	{
+		for (auto& queued : m_Events)
+		{
+			queued.Data->~Event();
+
+			if (queued.OnHeap)
+				Allocator::Free(queued.Data);
+		}
+
+		m_Events.clear();
+		m_NextToDispatch = 0;
+		m_ArenaOffset = 0;
+	}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Zahra/Core/Types.h"
+#include "Zahra/Events/Event.h"
+
+#include <functional>
+#include <vector>
+
+namespace Zahra
+{
+	/**
+	 * @brief Struct containing counts of events passing through an EventQueue, since it was created.
+	 */
+	struct EventQueueStats
+	{
+		uint64_t EventsQueued = 0; /**< @brief Events pushed, including those coalesced away. */
+		uint64_t EventsCoalesced = 0; /**< @brief Events that replaced the previous queued event, rather than being dispatched separately. */
+		uint64_t EventsDispatched = 0;
+		uint32_t OverflowCount = 0; /**< @brief Events that didn't fit in the arena, and so were copied onto the general heap. */
+	};
+
+	/**
+	 * @brief Buffers events as they arrive from the OS, so that they can be dispatched together at a defined point in the frame.
+	 *
+	 * Events are copied into a linear arena, which is reset once the queue has been dispatched. If an event arrives
+	 * while the previous queued event has the same type, and is of a type whose latest value supersedes earlier ones
+	 * (mouse moves, window resizes and moves), it overwrites that event rather than being queued separately. So a
+	 * high polling rate mouse, or dragging the window border, costs one dispatch per frame instead of hundreds.
+	 * Anything else (button presses, key presses, scrolling etc.) is dispatched individually and in order.
+	 *
+	 * For use on the main thread only.
+	 */
+	class EventQueue
+	{
+	public:
+		using EventHandlerFn = std::function<void(Event&)>;
+
+		/**
+		 * @param arenaSize Size (in bytes) of the arena queued events are copied into, before spilling onto the heap.
+		 */
+		EventQueue(uint64_t arenaSize = 64 * 1024);
+		~EventQueue();
+
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		/**
+		 * @brief Copy an event into the queue, coalescing it with the previous queued event where possible.
+		 */
+		void Push(const Event& event);
+
+		/**
+		 * @brief Pass every queued event to handler, in order, then empty the queue. Events pushed during
+		 * dispatch (e.g. by a handler resizing the window) are dispatched in the same call.
+		 */
+		void Dispatch(const EventHandlerFn& handler);
+
+		bool IsEmpty() const { return m_Events.empty(); }
+
+		const EventQueueStats& GetStats() const { return m_Stats; }
+
+	private:
+		struct QueuedEvent
+		{
+			Event* Data = nullptr;
+			bool OnHeap = false;
+		};
+
+		std::vector<QueuedEvent> m_Events;
+		size_t m_NextToDispatch = 0; // events before this index are being (or have been) handled, so mustn't be overwritten
+
+		byte* m_Arena = nullptr;
+		uint64_t m_ArenaSize = 0;
+		uint64_t m_ArenaOffset = 0;
+
+		EventQueueStats m_Stats;
+
+		void Clear();
+	};
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Zahra/Debug/Profiling.h"
+#include "Zahra/Renderer/Renderer.h"
+
+namespace Zahra
+{
+	/**
+	 * @brief Brackets the GPU commands recorded during its lifetime with timestamp queries. The resulting timings turn
+	 * up a few frames later, on the profiler's "GPU" lane. Every render pass is timed like this automatically.
+	 */
+	class GPUProfileScope
+	{
+	public:
+		GPUProfileScope(const char* name)
+		{
+			Renderer::BeginGPUScope(name);
+		}
+
+		~GPUProfileScope()
+		{
+			Renderer::EndGPUScope();
+		}
+
+		GPUProfileScope(const GPUProfileScope&) = delete;
+		GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+	};
+
+}
+
+#if Z_PROFILING_ENABLED
+	#define Z_PROFILE_GPU_SCOPE(name) ::Zahra::GPUProfileScope gpuTimer##__LINE__(name)
+#else
+	#define Z_PROFILE_GPU_SCOPE(name)
+#endif
@@ -45,8 +45,8 @@ namespace Zahra
 	public:
 		virtual ~Mesh() {};
 
-		virtual Ref<VertexBuffer> GetVertexBuffer() = 0;
-		virtual Ref<IndexBuffer> GetIndexBuffer() = 0;
+		virtual RefView<VertexBuffer> GetVertexBuffer() = 0;
+		virtual RefView<IndexBuffer> GetIndexBuffer() = 0;
 
 		static Ref<Mesh> CreateFromFile(MeshSpecification specification, const std::filesystem::path& filepath);
 
@@ -2,6 +2,7 @@
 #include "Renderer.h"
 
 #include "Zahra/Core/Types.h"
+#include "Zahra/Debug/Metrics.h"
 #include "Zahra/Projects/Project.h"
 #include "Zahra/Renderer/IndexBuffer.h"
 #include "Zahra/Renderer/Mesh.h"
@@ -24,6 +25,7 @@ namespace Zahra
 
 		Renderer::GPUCapabilities		GPUCapabilities;
 		Renderer::Statistics			Statistics;
+		MetricCounter*					DrawCallMetric = nullptr;
 
 		Ref<Image2D>					PrimaryRenderTargetImage;
 		Ref<Texture2D>					PrimaryRenderTargetTexture;
@@ -47,6 +49,8 @@ namespace Zahra
 		s_RendererAPI = RendererAPI::Create();
 		s_RendererAPI->Init();
 
+		s_Data.DrawCallMetric = &Metrics::GetCounter("renderer.draw_calls");
+
 		////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// PRIMARY RENDER TARGET
 		{
@@ -214,6 +218,16 @@ namespace Zahra
 		s_RendererAPI->Present();
 	}
 
+	void Renderer::BeginGPUScope(const char* name)
+	{
+		s_RendererAPI->BeginGPUScope(name);
+	}
+
+	void Renderer::EndGPUScope()
+	{
+		s_RendererAPI->EndGPUScope();
+	}
+
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		s_RendererAPI->OnWindowResize();
@@ -235,6 +249,7 @@ namespace Zahra
 		s_RendererAPI->Draw(renderPass, vertexBuffer, vertexCount);
 
 		s_Data.Statistics.DrawCallCount++;
+		s_Data.DrawCallMetric->Increment();
 	}
 
 	void Renderer::DrawIndexed(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, Ref<IndexBuffer>& indexBuffer, uint32_t indexCount, uint32_t startingIndex)
@@ -242,6 +257,7 @@ namespace Zahra
 		s_RendererAPI->DrawIndexed(renderPass, vertexBuffer, indexBuffer, indexCount, startingIndex);
 
 		s_Data.Statistics.DrawCallCount++;
+		s_Data.DrawCallMetric->Increment();
 	}
 
 	void Renderer::DrawMesh(Ref<RenderPass>& renderPass, Ref<Mesh>& mesh)
@@ -249,6 +265,7 @@ namespace Zahra
 		s_RendererAPI->DrawMesh(renderPass, mesh);
 
 		s_Data.Statistics.DrawCallCount++;
+		s_Data.DrawCallMetric->Increment();
 
 	}
 
@@ -36,6 +36,9 @@ namespace Zahra
 		static void EndRenderPass();
 		static void Present();
 
+		static void BeginGPUScope(const char* name);
+		static void EndGPUScope();
+
 		static void OnWindowResize(uint32_t width, uint32_t height);
 
 		static void Draw(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, uint32_t vertexCount);
@@ -1,6 +1,8 @@
 #include "zpch.h"
 #include "Renderer2D.h"
 
+#include "Zahra/Debug/Metrics.h"
+#include "Zahra/Renderer/GPUProfiling.h"
 #include "Zahra/Renderer/Text/MSDF.h"
 
 namespace Zahra
@@ -311,6 +313,8 @@ namespace Zahra
 
 	void Renderer2D::BeginScene(const glm::mat4& cameraView, const glm::mat4& cameraProjection)
 	{
+		m_SceneStartStats = m_Stats;
+
 		glm::mat4 cameraPV = cameraProjection * cameraView;
 
 		m_CameraUniformBuffers->SetData(Renderer::GetCurrentFrameIndex(), &cameraPV, sizeof(glm::mat4));
@@ -343,6 +347,8 @@ namespace Zahra
 
 	void Renderer2D::EndScene()
 	{
+		Z_PROFILE_GPU_SCOPE("Renderer2D::EndScene");
+
 		uint32_t frame = Renderer::GetCurrentFrameIndex();
 
 		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -454,6 +460,33 @@ namespace Zahra
 			}
 		}
 		Renderer::EndRenderPass();
+
+		PublishSceneStats();
+	}
+
+	void Renderer2D::PublishSceneStats()
+	{
+		static MetricCounter& quads = Metrics::GetCounter("renderer2d.quads");
+		static MetricCounter& quadBatches = Metrics::GetCounter("renderer2d.quad_batches");
+		static MetricCounter& circles = Metrics::GetCounter("renderer2d.circles");
+		static MetricCounter& circleBatches = Metrics::GetCounter("renderer2d.circle_batches");
+		static MetricCounter& lines = Metrics::GetCounter("renderer2d.lines");
+		static MetricCounter& lineBatches = Metrics::GetCounter("renderer2d.line_batches");
+		static MetricCounter& strings = Metrics::GetCounter("renderer2d.strings");
+		static MetricCounter& chars = Metrics::GetCounter("renderer2d.chars");
+		static MetricCounter& textBatches = Metrics::GetCounter("renderer2d.text_batches");
+		static MetricCounter& drawCalls = Metrics::GetCounter("renderer2d.draw_calls");
+
+		quads.Increment(m_Stats.QuadCount - m_SceneStartStats.QuadCount);
+		quadBatches.Increment(m_Stats.QuadBatchCount - m_SceneStartStats.QuadBatchCount);
+		circles.Increment(m_Stats.CircleCount - m_SceneStartStats.CircleCount);
+		circleBatches.Increment(m_Stats.CircleBatchCount - m_SceneStartStats.CircleBatchCount);
+		lines.Increment(m_Stats.LineCount - m_SceneStartStats.LineCount);
+		lineBatches.Increment(m_Stats.LineBatchCount - m_SceneStartStats.LineBatchCount);
+		strings.Increment(m_Stats.StringCount - m_SceneStartStats.StringCount);
+		chars.Increment(m_Stats.CharCount - m_SceneStartStats.CharCount);
+		textBatches.Increment(m_Stats.TextBatchCount - m_SceneStartStats.TextBatchCount);
+		drawCalls.Increment(m_Stats.DrawCalls - m_SceneStartStats.DrawCalls);
 	}
 
 	void Renderer2D::AddNewQuadBatch()
@@ -548,7 +581,7 @@ namespace Zahra
 		m_Stats.QuadCount++;
 	}
 
-	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec4& tint, float tiling, int entityID)
+	void Renderer2D::DrawQuad(const glm::mat4& transform, RefView<Texture2D> texture, const glm::vec4& tint, float tiling, int entityID)
 	{
 		Z_CORE_VERIFY(texture);
 
@@ -564,9 +597,10 @@ namespace Zahra
 		uint32_t textureIndex = 0;
 		{
 			// check if texture is already in our array
+			AssetHandle textureHandle = texture->GetAssetHandle();
 			for (uint32_t i = 1; i < m_TextureSlotsInUse; i++)
 			{
-				if (m_TextureSlots[i]->GetAssetHandle() == texture->GetAssetHandle())
+				if (m_TextureSlots[i].Raw() == texture.Raw() || m_TextureSlots[i]->GetAssetHandle() == textureHandle)
 				{
 					textureIndex = i;
 					break;
@@ -579,7 +613,7 @@ namespace Zahra
 				Z_CORE_ASSERT(m_TextureSlotsInUse < m_Specification.MaxTextureSlots, "Reached maximum bound textures");
 
 				textureIndex = m_TextureSlotsInUse;
-				m_TextureSlots[textureIndex] = texture;
+				m_TextureSlots[textureIndex] = texture.ToRef();
 				m_TextureSlotsInUse++;
 			}
 		}
@@ -666,21 +700,21 @@ namespace Zahra
 
 	void Renderer2D::DrawString(const glm::mat4 transform, const std::string& string, StringSpecification& spec, int entityID)
 	{
-		auto font = spec.Font;
+		RefView<Font> font = spec.Font;
 		Z_CORE_VERIFY(font);
 		
 		auto fontGeometry = font->GetMSDFData()->FontGeometry;
 		auto fontMetrics = fontGeometry.getMetrics();
 		auto fontAssetHandle = font->GetAssetHandle();
-		auto atlasTexture = font->GetAtlasTexture();
+		RefView<Texture2D> atlasTexture = font->GetAtlasTexture();
 
 		uint32_t batch;
 		
 		// organising batches by font
-		auto it = std::find_if(m_Fonts.rbegin(), m_Fonts.rend(), [fontAssetHandle](Ref<Font> f){ return f->GetAssetHandle() == fontAssetHandle; });
+		auto it = std::find_if(m_Fonts.rbegin(), m_Fonts.rend(), [fontAssetHandle](const Ref<Font>& f){ return f->GetAssetHandle() == fontAssetHandle; });
 		if (it == m_Fonts.rend())
 		{
-			m_Fonts.emplace_back(font);
+			m_Fonts.emplace_back(font.ToRef());
 			m_Stats.FontCount++;
 			MaybeAddNewTextBatch();
 			batch = m_Fonts.size() - 1;
@@ -710,7 +744,7 @@ namespace Zahra
 			// check for batch overflow
 			if (m_TextBatchEnds[batch] - m_TextBatchStarts[batch] >= c_MaxQuadVerticesPerBatch)
 			{
-				m_Fonts.emplace_back(font);
+				m_Fonts.emplace_back(font.ToRef());
 				MaybeAddNewTextBatch();
 				batch = m_Fonts.size() - 1;
 				m_Stats.TextBatchCount++;
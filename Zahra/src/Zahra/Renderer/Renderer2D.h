@@ -95,7 +95,7 @@ namespace Zahra
 
 		// TODO: Add billboarded options
 		void DrawQuad(const glm::mat4& transform, const glm::vec4& colour, int entityID = -1);
-		void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec4& tint = { 1.0f, 1.0f, 1.0f, 1.0f }, float tiling = 1.0f, int entityID = -1);
+		void DrawQuad(const glm::mat4& transform, RefView<Texture2D> texture, const glm::vec4& tint = { 1.0f, 1.0f, 1.0f, 1.0f }, float tiling = 1.0f, int entityID = -1);
 		void DrawCircle(const glm::mat4& transform, const glm::vec4& colour, float thickness, float fade, int entityID = -1);
 		void DrawLine(const glm::vec3& end0, const glm::vec3& end1, const glm::vec4& colour, int entityID = -1);
 		void DrawQuadBoundingBox(const glm::mat4& transform, const glm::vec4& colour, int entityID = -1, glm::vec3 rescale = {1.0f, 1.0f, 1.0f});
@@ -141,6 +141,7 @@ namespace Zahra
 		float m_LineWidth = 1.5f;
 
 		Statistics m_Stats;
+		Statistics m_SceneStartStats; // m_Stats as of BeginScene, so that each scene's share can be published to Metrics
 
 		ShaderLibrary m_ShaderLibrary;
 
@@ -211,5 +212,7 @@ namespace Zahra
 		void AddNewCircleBatch();
 		void AddNewLineBatch();
 		void MaybeAddNewTextBatch();
+
+		void PublishSceneStats();
 	};
 }
@@ -50,6 +50,10 @@ namespace Zahra
 		virtual void BeginRenderPass(Ref<RenderPass>& renderPass, bool bindPipeline = true, bool clearAttachments = false) = 0;
 		virtual void EndRenderPass() = 0;
 
+		// bracket the commands recorded in between with GPU timestamps (see Z_PROFILE_GPU_SCOPE)
+		virtual void BeginGPUScope(const char* name) = 0;
+		virtual void EndGPUScope() = 0;
+
 		virtual void Draw(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, uint32_t vertexCount) = 0;
 		virtual void DrawIndexed(Ref<RenderPass>& renderPass, Ref<VertexBuffer>& vertexBuffer, Ref<IndexBuffer>& indexBuffer, uint32_t indexCount = 0, uint32_t startingIndex = 0) = 0;
 		virtual void DrawMesh(Ref<RenderPass>& renderPass, Ref<Mesh>& mesh) = 0;
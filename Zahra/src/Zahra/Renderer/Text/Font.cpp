@@ -70,9 +70,10 @@ namespace Zahra
 			spec.GenerateMips = false;
 		}
 
-		Buffer pixelBuffer(bitmap.pixels, atlasSpec.Width * atlasSpec.Height * Image::BytesPerPixel(spec.Format));
+		// the generator owns the atlas storage, so this is the one copy the pixels need
+		SharedBuffer pixelBuffer = SharedBuffer::Copy(BufferView(bitmap.pixels, (uint64_t)atlasSpec.Width * atlasSpec.Height * Image::BytesPerPixel(spec.Format)));
 
-		return Texture2D::CreateFromBuffer(spec, pixelBuffer);
+		return Texture2D::CreateFromBuffer(spec, std::move(pixelBuffer));
 	}
 
 	Font::Font(const std::filesystem::path& filepath, CharacterSet characterSet)
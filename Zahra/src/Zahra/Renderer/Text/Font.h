@@ -35,7 +35,7 @@ namespace Zahra
 		~Font();
 
 		const MSDFData* GetMSDFData() { return m_Data; }
-		Ref<Texture2D> GetAtlasTexture() { return m_AtlasTexture; }
+		const Ref<Texture2D>& GetAtlasTexture() { return m_AtlasTexture; }
 
 		static AssetType GetAssetTypeStatic() { return AssetType::Font; }
 		virtual AssetType GetAssetType() const override { return GetAssetTypeStatic(); }
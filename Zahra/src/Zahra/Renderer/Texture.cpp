@@ -2,13 +2,14 @@
 #include "Texture.h"
 
 #include "Platform/Vulkan/VulkanTexture.h"
+#include "Zahra/Core/Task.h"
 #include "Zahra/Renderer/Renderer.h"
 
 #include <stb_image.h>
 
 namespace Zahra
 {
-	Ref<Texture2D> Texture2D::CreateFromBuffer(const TextureSpecification& specification, Buffer imageData)
+	Ref<Texture2D> Texture2D::CreateFromBuffer(const TextureSpecification& specification, SharedBuffer imageData)
 	{
 		switch (Renderer::GetAPI())
 		{
@@ -55,16 +56,48 @@ namespace Zahra
 	Ref<Texture2D> TextureLoader::LoadTexture2DFromSource(const std::filesystem::path& sourceFilepath, bool generateMips)
 	{
 		TextureSpecification spec{};
-		Buffer imageData = LoadImageData(sourceFilepath, spec.Width, spec.Height, spec.Format);
+		SharedBuffer imageData = LoadImageData(sourceFilepath, spec.Width, spec.Height, spec.Format);
 		spec.GenerateMips = generateMips;
 
-		Ref<Texture2D> newTexture = Texture2D::CreateFromBuffer(spec, imageData);
+		return Texture2D::CreateFromBuffer(spec, std::move(imageData));
+	}
+
+	Task<Ref<Asset>> TextureLoader::LoadTexture2DAssetAsync(const AssetHandle& handle, const AssetMetadata& metadata)
+	{
+		return DecodeImageAsync(metadata.Filepath, true)
+			.ThenOnMainThread([](DecodedImage& image) -> Ref<Asset>
+			{
+				if (!image.ImageData)
+					return nullptr;
 
-		stbi_image_free(imageData.Data);
-		return newTexture;
+				return Texture2D::CreateFromBuffer(image.Specification, std::move(image.ImageData));
+			});
+	}
+
+	Task<Ref<Texture2D>> TextureLoader::LoadTexture2DFromSourceAsync(const std::filesystem::path& sourceFilepath, bool generateMips)
+	{
+		return DecodeImageAsync(sourceFilepath, generateMips)
+			.ThenOnMainThread([](DecodedImage& image) -> Ref<Texture2D>
+			{
+				if (!image.ImageData)
+					return nullptr;
+
+				return Texture2D::CreateFromBuffer(image.Specification, std::move(image.ImageData));
+			});
+	}
+
+	Task<TextureLoader::DecodedImage> TextureLoader::DecodeImageAsync(const std::filesystem::path& sourceFilepath, bool generateMips)
+	{
+		return Async::Run([sourceFilepath, generateMips]()
+			{
+				DecodedImage image;
+				image.ImageData = LoadImageData(sourceFilepath, image.Specification.Width, image.Specification.Height, image.Specification.Format);
+				image.Specification.GenerateMips = generateMips;
+				return image;
+			}, "TextureLoader::LoadImageData");
 	}
 
-	Buffer TextureLoader::LoadImageData(const std::filesystem::path& sourceFilepath, uint32_t& widthOut, uint32_t& heightOut, ImageFormat& formatOut)
+	SharedBuffer TextureLoader::LoadImageData(const std::filesystem::path& sourceFilepath, uint32_t& widthOut, uint32_t& heightOut, ImageFormat& formatOut)
 	{
 		int width = 0, height = 0, channels = 4;
 		bool validfilepath = std::filesystem::exists(sourceFilepath);
@@ -83,7 +116,7 @@ namespace Zahra
 			imageData = stbi_load(filepathString.c_str(), &width, &height, &channels, channels);
 
 			if (!imageData)
-				return nullptr;
+				return {};
 
 			widthOut = width;
 			heightOut = height;
@@ -108,8 +141,8 @@ namespace Zahra
 			}
 		}
 
-		Buffer buffer((void*)imageData, (uint64_t)(width * height * Image::BytesPerPixel(formatOut)));
-		return buffer;
+		// hand stb's allocation straight to the texture, rather than copying it
+		return SharedBuffer::Adopt(imageData, (uint64_t)width * height * Image::BytesPerPixel(formatOut), stbi_image_free);
 	}
 
 }
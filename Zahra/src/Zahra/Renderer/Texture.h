@@ -10,6 +10,9 @@
 
 namespace Zahra
 {
+	template<typename T>
+	class Task;
+
 	enum class TextureShape
 	{
 		Rectangular,
@@ -48,7 +51,7 @@ namespace Zahra
 		// image, and only do so after the image has already been resized
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
 
-		static Ref<Texture2D> CreateFromBuffer(const TextureSpecification& specification, Buffer imageData);
+		static Ref<Texture2D> CreateFromBuffer(const TextureSpecification& specification, SharedBuffer imageData);
 		static Ref<Texture2D> CreateFromImage2D(Ref<Image2D>& image);
 		static Ref<Texture2D> CreateFlatColourTexture(const TextureSpecification& specification, uint32_t colour);
 	};
@@ -59,8 +62,20 @@ namespace Zahra
 		static Ref<Texture2D> LoadTexture2DAsset(const AssetHandle& handle, const AssetMetadata& metadata);
 		static Ref<Texture2D> LoadTexture2DFromSource(const std::filesystem::path& sourceFilepath, bool generateMips = false);
 
+		// reads and decodes the image on a worker thread, then creates the texture on the main thread (include
+		// Zahra/Core/Task.h to use the result)
+		static Task<Ref<Asset>> LoadTexture2DAssetAsync(const AssetHandle& handle, const AssetMetadata& metadata);
+		static Task<Ref<Texture2D>> LoadTexture2DFromSourceAsync(const std::filesystem::path& sourceFilepath, bool generateMips = false);
+
 	private:
-		static Buffer LoadImageData(const std::filesystem::path& sourceFilepath, uint32_t& widthOut, uint32_t& heightOut, ImageFormat& formatOut);
+		struct DecodedImage
+		{
+			TextureSpecification Specification;
+			SharedBuffer ImageData;
+		};
+
+		static Task<DecodedImage> DecodeImageAsync(const std::filesystem::path& sourceFilepath, bool generateMips);
+		static SharedBuffer LoadImageData(const std::filesystem::path& sourceFilepath, uint32_t& widthOut, uint32_t& heightOut, ImageFormat& formatOut);
 	};
 
 }
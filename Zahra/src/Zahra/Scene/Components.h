@@ -218,6 +218,10 @@ namespace Zahra
 		// physics engine, using the entity uuid
 		void* RuntimeBody = nullptr;
 
+		// the body's state as of the previous simulation step, for interpolating rendered transforms
+		glm::vec2 PreviousPosition = { .0f, .0f };
+		float PreviousAngle = .0f;
+
 		RigidBody2DComponent() = default;
 		RigidBody2DComponent(const RigidBody2DComponent&) = default;
 
@@ -30,6 +30,7 @@ namespace Zahra
 		T& AddComponent(Args&& ...args)
 		{
 			Z_CORE_ASSERT(!HasComponents<T>(), "Entity already has a component of this type.");
+			Z_CORE_ASSERT(!m_Scene->IsIteratingInParallel(), "Can't add components during Scene::ParallelForEach");
 			
 			T& component =  m_Scene->m_Registry.emplace<T>(m_EntityHandle, std::forward<Args>(args)...);
 			
@@ -39,6 +40,8 @@ namespace Zahra
 		template<typename T, typename ...Args>
 		T& AddOrReplaceComponent(Args&& ...args)
 		{
+			Z_CORE_ASSERT(!m_Scene->IsIteratingInParallel(), "Can't add components during Scene::ParallelForEach");
+
 			T& component = m_Scene->m_Registry.emplace_or_replace<T>(m_EntityHandle, std::forward<Args>(args)...);
 
 			return component;
@@ -48,6 +51,7 @@ namespace Zahra
 		void RemoveComponent()
 		{
 			Z_CORE_ASSERT(HasComponents<T>(), "Entity does not have component of requested type.");
+			Z_CORE_ASSERT(!m_Scene->IsIteratingInParallel(), "Can't remove components during Scene::ParallelForEach");
 
 			m_Scene->m_Registry.remove<T>(m_EntityHandle);
 		}
@@ -2,6 +2,8 @@
 #include "Scene.h"
 
 #include "Zahra/Assets/AssetManager.h"
+#include "Zahra/Core/Task.h"
+#include "Zahra/Debug/Metrics.h"
 #include "Zahra/Renderer/Renderer.h"
 #include "Zahra/Scene/Components.h"
 #include "Zahra/Scene/Entity.h"
@@ -18,6 +20,13 @@ namespace Zahra
 {
 	static Scene::DebugRenderSettings s_DebugRenderSettings;
 
+	// reported by whichever scene is being rendered
+	static void PublishEntityCount(size_t count)
+	{
+		static MetricGauge& entities = Metrics::GetGauge("scene.entities");
+		entities.Set((double)count);
+	}
+
 	Scene::Scene(const std::string& sceneName)
 	{
 		m_SceneName = sceneName;
@@ -36,11 +45,9 @@ namespace Zahra
 
 	Scene::~Scene()
 	{
-		m_EntityMap.clear();
+		m_EntityMap.Clear();
 		m_Registry.clear();
 
-		for (auto& [uuid, buffer] : m_ScriptFieldStorage)
-			buffer.Release();
 		m_ScriptFieldStorage.clear();
 	}
 
@@ -116,13 +123,9 @@ namespace Zahra
 		Entity oldCamera = srcScene->GetActiveCamera();
 		if (oldCamera) destScene->SetActiveCamera({ uuidToNewHandle[oldCamera.GetID()] , destScene.Raw() });
 
-		// copy field storage buffer
+		// share field storage buffers (each is only copied once either scene writes to it)
 		for (auto& [uuid, srcBuffer] : srcScene->m_ScriptFieldStorage)
-		{
-			auto& destBuffer = destScene->m_ScriptFieldStorage[uuid];
-			destBuffer.Release();
-			destBuffer = Buffer::Copy(srcBuffer);
-		}
+			destScene->m_ScriptFieldStorage[uuid] = srcBuffer;
 
 		return destScene;
 	}
@@ -130,6 +133,8 @@ namespace Zahra
 	// All entities will automatically be created with an IDComponent, TagComponent and TransformComponent
 	Entity Scene::CreateEntity(const std::string& name)
 	{
+		Z_CORE_ASSERT(!IsIteratingInParallel(), "Can't create entities during Scene::ParallelForEach");
+
 		Entity entity = { m_Registry.create(), this };
 		entity.GetComponents<TagComponent>().Tag = name;
 		m_EntityMap[entity.GetID()] = entity;
@@ -138,6 +143,8 @@ namespace Zahra
 
 	Entity Scene::CreateEntity(uint64_t uuid, const std::string& name)
 	{
+		Z_CORE_ASSERT(!IsIteratingInParallel(), "Can't create entities during Scene::ParallelForEach");
+
 		Entity entity = { m_Registry.create(), this };
 		entity.GetComponents<TagComponent>().Tag = name;
 		entity.GetComponents<IDComponent>().ID = { uuid };
@@ -147,22 +154,26 @@ namespace Zahra
 
 	void Scene::DestroyEntity(Entity entity)
 	{
+		Z_CORE_ASSERT(!IsIteratingInParallel(), "Can't destroy entities during Scene::ParallelForEach");
+
 		if ((entt::entity)entity == m_ActiveCamera)
 			m_ActiveCamera = entt::null;
 
-		m_EntityMap.erase(entity.GetID());
+		m_EntityMap.Erase(entity.GetID());
 		m_Registry.destroy(entity);
 	}
 
 	void Scene::DestroyEntity(UUID uuid)
 	{
-		auto it = m_EntityMap.find(uuid);
-		if (it == m_EntityMap.end())
+		Z_CORE_ASSERT(!IsIteratingInParallel(), "Can't destroy entities during Scene::ParallelForEach");
+
+		entt::entity* entity = m_EntityMap.Find(uuid);
+		if (!entity)
 			return;
 
-		auto entity = it->second;
-		m_EntityMap.erase(uuid);
-		m_Registry.destroy(entity);
+		entt::entity handle = *entity;
+		m_EntityMap.Erase(uuid);
+		m_Registry.destroy(handle);
 	}
 
 	Entity Scene::DuplicateEntity(Entity extantEntity, UUID newID)
@@ -179,11 +190,11 @@ namespace Zahra
 
 	Entity Scene::GetEntity(UUID uuid)
 	{
-		auto it = m_EntityMap.find(uuid);
-		if (it == m_EntityMap.end())
+		entt::entity* entity = m_EntityMap.Find(uuid);
+		if (!entity)
 			return { entt::null, this };
 
-		return { it->second, this };
+		return { *entity, this };
 	}
 
 	void Scene::ForEachEntity(const std::function<void(Entity entity)>& action)
@@ -306,12 +317,12 @@ namespace Zahra
 		
 	}
 
-	void Scene::OnUpdateSimulation(float dt)
+	void Scene::OnFixedUpdateSimulation(float dt)
 	{
 		UpdatePhysicsWorld(dt);
 	}
 
-	void Scene::OnUpdateRuntime(float dt)
+	void Scene::OnFixedUpdateRuntime(float dt)
 	{
 		auto& view = m_Registry.view<ScriptComponent>();
 
@@ -330,8 +341,10 @@ namespace Zahra
 		}
 	}
 
-	void Scene::OnRenderEditor(Ref<Renderer2D> renderer, const EditorCamera& camera, Entity selection, const glm::vec4& highlightColour)
+	void Scene::OnRenderEditor(RefView<Renderer2D> renderer, const EditorCamera& camera, Entity selection, const glm::vec4& highlightColour)
 	{
+		PublishEntityCount(m_EntityMap.Size());
+
 		renderer->ResetStats();
 
 		if (s_DebugRenderSettings.LineWidth > 0.0f)
@@ -345,12 +358,14 @@ namespace Zahra
 		renderer->EndScene();
 	}
 
-	void Scene::OnRenderRuntime(Ref<Renderer2D> renderer, Entity selection, const glm::vec4& highlightColour)
+	void Scene::OnRenderRuntime(RefView<Renderer2D> renderer, Entity selection, const glm::vec4& highlightColour)
 	{
+		PublishEntityCount(m_EntityMap.Size());
+
 		if (m_ActiveCamera != entt::null)
 		{
 			Entity activeCameraEntity(m_ActiveCamera, this);
-			glm::mat4 cameraView = glm::inverse(activeCameraEntity.GetComponents<TransformComponent>().GetTransform());
+			glm::mat4 cameraView = glm::inverse(GetRenderTransform(m_ActiveCamera, activeCameraEntity.GetComponents<TransformComponent>()));
 			glm::mat4 cameraProjection = activeCameraEntity.GetComponents<CameraComponent>().Camera.GetProjection();
 
 			renderer->ResetStats();
@@ -405,6 +420,8 @@ namespace Zahra
 
 			auto physicsBody = m_PhysicsWorld->CreateBody(&bodyDef);
 			bodyComp.RuntimeBody = (void*)physicsBody;
+			bodyComp.PreviousPosition = { bodyDef.position.x, bodyDef.position.y };
+			bodyComp.PreviousAngle = bodyDef.angle;
 			physicsBody->SetFixedRotation(bodyComp.FixedRotation);
 
 			if (entity.HasComponents<RectColliderComponent>())
@@ -453,25 +470,23 @@ namespace Zahra
 
 		m_PhysicsWorld->Step(dt, velocityIterations, positionIterations);
 
-		// Retrieve resultant transforms
-		auto view = m_Registry.view<RigidBody2DComponent>();
-		for (auto e : view)
-		{
-			Entity entity = { e, this };
-			auto& tc = entity.GetComponents<TransformComponent>();
-			auto& bc = entity.GetComponents<RigidBody2DComponent>();
+		// Retrieve resultant transforms (the world is only read from here, so bodies can be processed in parallel)
+		ParallelForEach<TransformComponent, RigidBody2DComponent>([](entt::entity e, TransformComponent& tc, RigidBody2DComponent& bc)
+			{
+				auto physicsBody = (b2Body*)bc.RuntimeBody;
 
-			auto physicsBody = (b2Body*)bc.RuntimeBody;
+				bc.PreviousPosition = { tc.Translation.x, tc.Translation.y };
+				bc.PreviousAngle = tc.GetEulers().z;
 
-			const auto& position = physicsBody->GetPosition();
-			const auto& rotation = physicsBody->GetAngle();
+				const auto& position = physicsBody->GetPosition();
+				const auto& rotation = physicsBody->GetAngle();
 
-			tc.Translation.x = position.x;
-			tc.Translation.y = position.y;
+				tc.Translation.x = position.x;
+				tc.Translation.y = position.y;
 
-			auto eulers = tc.GetEulers();
-			tc.SetRotation({ eulers.x, eulers.y, rotation });
-		}
+				auto eulers = tc.GetEulers();
+				tc.SetRotation({ eulers.x, eulers.y, rotation });
+			});
 	}
 
 	void Scene::OnViewportResize(float width, float height)
@@ -479,15 +494,14 @@ namespace Zahra
 		m_ViewportWidth = width;
 		m_ViewportHeight = height;
 
-		auto cameraEntities = m_Registry.view<CameraComponent>();
-		for (auto entity : cameraEntities)
-		{
-			auto& cameraComponent = cameraEntities.get<CameraComponent>(entity);
-			if (!cameraComponent.FixedAspectRatio)
+		// scenes have a camera or two, so this isn't worth handing to the JobSystem
+		m_Registry.view<CameraComponent>().each([width, height](entt::entity e, CameraComponent& cameraComponent)
 			{
-				cameraComponent.Camera.SetViewportSize(width, height);
-			}
-		}
+				if (!cameraComponent.FixedAspectRatio)
+				{
+					cameraComponent.Camera.SetViewportSize(width, height);
+				}
+			});
 	}
 
 	void Scene::SetActiveCamera(Entity entity)
@@ -527,13 +541,21 @@ namespace Zahra
 
 			if (buffer.GetSize() != 16 * fieldCount)
 			{
-				buffer.Allocate(16 * fieldCount);
+				buffer = SharedBuffer::Allocate(16 * fieldCount);
 				buffer.ZeroInitialise();
 			}
 		}
 	}
 
-	Buffer Scene::GetScriptFieldStorage(Entity entity)
+	BufferView Scene::GetScriptFieldStorage(Entity entity) const
+	{
+		auto result = m_ScriptFieldStorage.find(entity.GetID());
+		Z_CORE_ASSERT(result != m_ScriptFieldStorage.end());
+
+		return result->second.View();
+	}
+
+	SharedBuffer& Scene::GetMutableScriptFieldStorage(Entity entity)
 	{
 		auto result = m_ScriptFieldStorage.find(entity.GetID());
 		Z_CORE_ASSERT(result != m_ScriptFieldStorage.end());
@@ -546,34 +568,119 @@ namespace Zahra
 		return s_DebugRenderSettings;
 	}
 
-	void Scene::RenderEntities(Ref<Renderer2D>& renderer)
+	void Scene::RenderEntities(RefView<Renderer2D> renderer)
 	{
-		auto spriteEntities = m_Registry.view<TransformComponent, SpriteComponent>();
-		for (auto entity : spriteEntities)
+		// Transforms are extracted in parallel, into arrays reused from frame to frame. The Renderer2D batches
+		// themselves aren't thread-safe, so draws are still submitted from this thread afterwards.
+		size_t spriteCapacity = m_Registry.view<TransformComponent, SpriteComponent>().size_hint();
+		if (m_SpriteDrawData.size() < spriteCapacity)
+			m_SpriteDrawData.resize(spriteCapacity);
+		auto sprites = m_SpriteDrawData.data();
+
+		uint32_t spriteCount = ParallelForEach<const TransformComponent, const SpriteComponent>(
+			[this, sprites](uint32_t index, entt::entity entity, const TransformComponent& transform, const SpriteComponent& sprite)
+			{
+				sprites[index] = { GetRenderTransform(entity, transform), &sprite, entity };
+			});
+
+		AssetHandle cachedTextureHandle = 0;
+		Ref<Texture2D> cachedTexture;
+
+		for (uint32_t i = 0; i < spriteCount; i++)
 		{
-			auto [transform, sprite] = spriteEntities.get<TransformComponent, SpriteComponent>(entity);
+			auto& [transform, sprite, entity] = sprites[i];
 
-			if (sprite.TextureHandle)
+			if (sprite->TextureHandle)
 			{
-				Ref<Texture2D> texture = AssetManager::GetAsset<Texture2D>(sprite.TextureHandle);
-				renderer->DrawQuad(transform.GetTransform(), texture, sprite.Tint, sprite.TextureTiling, (int)entity);
+				if (sprite->TextureHandle != cachedTextureHandle)
+				{
+					cachedTextureHandle = sprite->TextureHandle;
+
+					// textures are loaded without stalling the frame, and until one arrives its sprites are drawn untextured
+					if (AssetManager::IsAssetLoaded(cachedTextureHandle))
+					{
+						cachedTexture = AssetManager::GetAsset<Texture2D>(cachedTextureHandle);
+					}
+					else
+					{
+						AssetManager::GetAssetAsync(cachedTextureHandle);
+						cachedTexture = nullptr;
+					}
+				}
+			}
+
+			if (sprite->TextureHandle && cachedTexture)
+			{
+				renderer->DrawQuad(transform, cachedTexture, sprite->Tint, sprite->TextureTiling, (int)entity);
 			}
 			else
 			{
-				renderer->DrawQuad(transform.GetTransform(), sprite.Tint, (int)entity);
+				renderer->DrawQuad(transform, sprite->Tint, (int)entity);
 			}
 		}
 
-		auto circleEntities = m_Registry.view<TransformComponent, CircleComponent>();
-		for (auto entity : circleEntities)
+		size_t circleCapacity = m_Registry.view<TransformComponent, CircleComponent>().size_hint();
+		if (m_CircleDrawData.size() < circleCapacity)
+			m_CircleDrawData.resize(circleCapacity);
+		auto circles = m_CircleDrawData.data();
+
+		uint32_t circleCount = ParallelForEach<const TransformComponent, const CircleComponent>(
+			[this, circles](uint32_t index, entt::entity entity, const TransformComponent& transform, const CircleComponent& circle)
+			{
+				circles[index] = { GetRenderTransform(entity, transform), &circle, entity };
+			});
+
+		for (uint32_t i = 0; i < circleCount; i++)
 		{
-			auto [transform, circle] = circleEntities.get<TransformComponent, CircleComponent>(entity);
+			auto& [transform, circle, entity] = circles[i];
 
-			renderer->DrawCircle(transform.GetTransform(), circle.Colour, circle.Thickness, circle.Fade, (int)entity);
+			renderer->DrawCircle(transform, circle->Colour, circle->Thickness, circle->Fade, (int)entity);
 		}
 	}
 
-	void Scene::RenderDebug(Ref<Renderer2D>& renderer, Entity selection, const glm::vec4& selectionColour)
+	std::vector<entt::entity> Scene::AcquireEntityScratch()
+	{
+		ScopedLock lock(m_EntityScratchMutex);
+
+		if (m_EntityScratch.empty())
+			return {};
+
+		std::vector<entt::entity> entities = std::move(m_EntityScratch.back());
+		m_EntityScratch.pop_back();
+		return entities;
+	}
+
+	void Scene::ReleaseEntityScratch(std::vector<entt::entity>&& entities)
+	{
+		entities.clear();
+
+		ScopedLock lock(m_EntityScratchMutex);
+		m_EntityScratch.push_back(std::move(entities));
+	}
+
+	glm::mat4 Scene::GetRenderTransform(entt::entity entity, const TransformComponent& transform) const
+	{
+		if (!m_PhysicsWorld || m_SimulationInterpolation >= 1.0f)
+			return transform.GetTransform();
+
+		auto body = m_Registry.try_get<RigidBody2DComponent>(entity);
+		if (!body || !body->RuntimeBody)
+			return transform.GetTransform();
+
+		// blend from the previous simulation step's state towards the current one
+		TransformComponent interpolated = transform;
+		glm::vec2 position = glm::mix(body->PreviousPosition, glm::vec2(transform.Translation), m_SimulationInterpolation);
+		interpolated.Translation.x = position.x;
+		interpolated.Translation.y = position.y;
+
+		glm::vec3 eulers = transform.GetEulers();
+		eulers.z = glm::mix(body->PreviousAngle, eulers.z, m_SimulationInterpolation);
+		interpolated.SetRotation(eulers);
+
+		return interpolated.GetTransform();
+	}
+
+	void Scene::RenderDebug(RefView<Renderer2D> renderer, Entity selection, const glm::vec4& selectionColour)
 	{
 		if (s_DebugRenderSettings.ShowColliders)
 		{
@@ -2,12 +2,18 @@
 
 #include "Zahra/Assets/Asset.h"
 #include "Zahra/Core/Buffer.h"
+#include "Zahra/Core/Mutex.h"
+#include "Zahra/Core/JobSystem.h"
+#include "Zahra/Core/UUIDMap.h"
 #include "Zahra/Renderer/Cameras/EditorCamera.h"
 #include "Zahra/Renderer/Renderer2D.h"
 #include "Zahra/Scene/Components.h"
 
 #include <entt.hpp>
 
+#include <atomic>
+#include <type_traits>
+
 // forward declare Box2D classes
 class b2World;
 class b2Body;
@@ -32,6 +38,63 @@ namespace Zahra
 		Entity GetEntity(UUID uuid);
 		void ForEachEntity(const std::function<void(Entity entity)>& action);
 
+		/**
+		 * @brief Run func on every entity with the given components, split into batches across the JobSystem's workers.
+		 *
+		 * func is called as func(entt::entity, Components&...), or as func(uint32_t index, entt::entity, Components&...)
+		 * where index is the entity's position in the iteration (handy for writing results into a pre-sized array).
+		 * Calls may run concurrently, so func should only touch the components it is handed, or other thread-safe data.
+		 * Entities and components can't be created or destroyed until this returns (asserted in debug builds).
+		 *
+		 * @param batchSize Number of entities per job (0 lets the JobSystem choose).
+		 * @return The number of entities visited.
+		 */
+		template<typename... Components, typename Func>
+		uint32_t ParallelForEach(Func func, uint32_t batchSize = 0)
+		{
+			auto view = m_Registry.view<Components...>();
+
+			// snapshot the matching entities (the view's own iterators can't be split into jobs), into a buffer
+			// reused from earlier calls, so this doesn't allocate once the scene has settled
+			std::vector<entt::entity> entities = AcquireEntityScratch();
+
+			// single-component views know their exact size, multi-component views only an upper bound
+			if constexpr (sizeof...(Components) == 1)
+				entities.reserve(view.size());
+			else
+				entities.reserve(view.size_hint());
+			for (auto entity : view)
+				entities.push_back(entity);
+
+			uint32_t count = (uint32_t)entities.size();
+
+			m_ParallelIterationDepth++;
+
+			JobSystem::ParallelFor(count, batchSize, [&](uint32_t begin, uint32_t end)
+				{
+					for (uint32_t i = begin; i < end; i++)
+					{
+						entt::entity entity = entities[i];
+
+						if constexpr (std::is_invocable_v<Func&, uint32_t, entt::entity, Components&...>)
+							func(i, entity, view.template get<Components>(entity)...);
+						else
+							func(entity, view.template get<Components>(entity)...);
+					}
+				}, "Scene::ParallelForEach").Wait();
+
+			m_ParallelIterationDepth--;
+
+			ReleaseEntityScratch(std::move(entities));
+
+			return count;
+		}
+
+		/**
+		 * @brief Is a ParallelForEach currently running over this scene?
+		 */
+		bool IsIteratingInParallel() const { return m_ParallelIterationDepth.load() > 0; }
+
 		// avoid this method as much as possible
 		Entity GetEntity(const std::string_view& name);
 
@@ -48,12 +111,18 @@ namespace Zahra
 		void OnSimulationStart();
 		void OnSimulationStop();
 
+		// per frame (variable dt)
 		void OnUpdateEditor(float dt);
-		void OnUpdateSimulation(float dt);
-		void OnUpdateRuntime(float dt);
 
-		void OnRenderEditor(Ref<Renderer2D> renderer, const EditorCamera& camera, Entity selection, const glm::vec4& highlightColour);
-		void OnRenderRuntime(Ref<Renderer2D> renderer, Entity selection, const glm::vec4& highlightColour);
+		// per simulation step (fixed dt, see Layer::OnFixedUpdate)
+		void OnFixedUpdateSimulation(float dt);
+		void OnFixedUpdateRuntime(float dt);
+
+		// fraction of a step to interpolate rendered physics bodies by, from their previous towards current state
+		void SetSimulationInterpolation(float alpha) { m_SimulationInterpolation = alpha; }
+
+		void OnRenderEditor(RefView<Renderer2D> renderer, const EditorCamera& camera, Entity selection, const glm::vec4& highlightColour);
+		void OnRenderRuntime(RefView<Renderer2D> renderer, Entity selection, const glm::vec4& highlightColour);
 
 		// TODO: replace Box2D with a 3d physics engine (e.g. Nvidia PhysX)
 		void InitPhysicsWorld();
@@ -68,7 +137,8 @@ namespace Zahra
 		Entity GetActiveCamera();
 
 		void AllocateScriptFieldStorage(Entity entity);
-		Buffer GetScriptFieldStorage(Entity entity);
+		BufferView GetScriptFieldStorage(Entity entity) const;
+		SharedBuffer& GetMutableScriptFieldStorage(Entity entity); // detaches from any copied scene on first write
 
 		struct DebugRenderSettings
 		{
@@ -87,14 +157,37 @@ namespace Zahra
 		std::string m_SceneName;
 
 		entt::basic_registry<entt::entity> m_Registry;
-		std::unordered_map<UUID, entt::entity> m_EntityMap;
+		UUIDMap<entt::entity> m_EntityMap;
 
 		entt::entity m_ActiveCamera = entt::null;
 		float m_ViewportWidth = 1.0f, m_ViewportHeight = 1.0f;
 
-		std::map<UUID, Buffer> m_ScriptFieldStorage;
+		std::map<UUID, SharedBuffer> m_ScriptFieldStorage;
+
+		std::atomic<uint32_t> m_ParallelIterationDepth = 0;
+
+		// spare ParallelForEach snapshots, one taken per call (so nested and concurrent calls each get their own)
+		std::vector<std::vector<entt::entity>> m_EntityScratch;
+		Mutex m_EntityScratchMutex{ "Scene::EntityScratch" };
+
+		std::vector<entt::entity> AcquireEntityScratch();
+		void ReleaseEntityScratch(std::vector<entt::entity>&& entities);
+
+		// a drawable component's world transform, extracted ahead of submission to the Renderer2D
+		template<typename Component>
+		struct DrawData
+		{
+			glm::mat4 Transform;
+			const Component* Drawable;
+			entt::entity Entity;
+		};
+
+		// kept between frames, so that RenderEntities only allocates when the scene grows
+		std::vector<DrawData<SpriteComponent>> m_SpriteDrawData;
+		std::vector<DrawData<CircleComponent>> m_CircleDrawData;
 
 		std::unique_ptr<b2World>(m_PhysicsWorld);
+		float m_SimulationInterpolation = 1.0f;
 		//std::map<entt::entity, b2Body*> m_PhysicsBodies;
 
 		friend class Entity;
@@ -102,8 +195,9 @@ namespace Zahra
 		friend class SceneSerialiser;
 
 		// TODO: move these to SceneRenderer
-		void RenderEntities(Ref<Renderer2D>& renderer);
-		void RenderDebug(Ref<Renderer2D>& renderer, Entity selection, const glm::vec4& highlightColour);
+		void RenderEntities(RefView<Renderer2D> renderer);
+		glm::mat4 GetRenderTransform(entt::entity entity, const TransformComponent& transform) const;
+		void RenderDebug(RefView<Renderer2D> renderer, Entity selection, const glm::vec4& highlightColour);
 	};
 
 }
@@ -481,7 +481,7 @@ namespace Zahra
 					if (fieldNodes && scriptClass)
 					{
 						auto fields = scriptClass->GetPublicFields();
-						auto buffer = m_Scene->GetScriptFieldStorage(entity);
+						auto& buffer = m_Scene->GetMutableScriptFieldStorage(entity);
 
 						for (uint64_t i = 0; i < fields.size(); i++)
 						{
@@ -22,12 +22,11 @@ namespace Zahra
 		{
 			Z_CORE_ASSERT(std::filesystem::exists(assemblyPath), "Assembly file does not exist");
 
-			uint32_t fileSize = 0;
-			char* assemblyFileContents = Zahra::FileIO::ReadBytes(assemblyPath, &fileSize);
+			SharedBuffer assemblyFileContents = Zahra::FileIO::ReadBuffer(assemblyPath);
 
 			// NOTE: We can't use this image for anything other than loading the assembly, because this image doesn't have a reference to the assembly
 			MonoImageOpenStatus status;
-			MonoImage* tempImage = mono_image_open_from_data_full(assemblyFileContents, fileSize, 1, &status, 0);
+			MonoImage* tempImage = mono_image_open_from_data_full((char*)assemblyFileContents.GetData<char>(), (uint32_t)assemblyFileContents.GetSize(), 1, &status, 0);
 
 			if (debugEnabled)
 			{
@@ -42,11 +41,9 @@ namespace Zahra
 					debugEnabled = false;
 				}
 
-				char* pdbFileContents = Zahra::FileIO::ReadBytes(debugDatabase, &fileSize);
+				SharedBuffer pdbFileContents = Zahra::FileIO::ReadBuffer(debugDatabase);
 
-				mono_debug_open_image_from_memory(tempImage, (const mono_byte*)pdbFileContents, fileSize);
-
-				delete[] pdbFileContents;
+				mono_debug_open_image_from_memory(tempImage, pdbFileContents.GetData<mono_byte>(), (int)pdbFileContents.GetSize());
 			}
 
 			if (status != MONO_IMAGE_OK)
@@ -60,7 +57,6 @@ namespace Zahra
 			assembly = mono_assembly_load_from_full(tempImage, assemblyPathString.c_str(), &status, 0);
 			
 			mono_image_close(tempImage);
-			delete[] assemblyFileContents;
 
 			if (!assembly)
 			{
@@ -499,11 +495,9 @@ namespace Zahra
 	{
 		Z_CORE_ASSERT(s_SEData->SceneContext);
 
-		char* string = mono_string_to_utf8(name);
-		Entity entity = s_SEData->SceneContext->GetEntity(string);
-		mono_free(string);
+		FrameString string = MonoStringToFrameString(name);
 
-		return entity;
+		return s_SEData->SceneContext->GetEntity(std::string_view(string.data(), string.size()));
 	}
 
 	MonoObject* ScriptEngine::GetMonoObject(UUID uuid)
@@ -521,6 +515,53 @@ namespace Zahra
 		return monoString;
 	}
 
+	FrameString ScriptEngine::MonoStringToFrameString(MonoString* string)
+	{
+		// mono_string_to_utf8 would hand us a fresh heap allocation (which we'd immediately free),
+		// so instead transcode the managed UTF-16 contents directly into the frame allocator
+		const mono_unichar2* chars = mono_string_chars(string);
+		int length = mono_string_length(string);
+
+		FrameString result;
+		result.reserve(3 * length);
+
+		for (int i = 0; i < length; i++)
+		{
+			uint32_t codepoint = chars[i];
+
+			if (codepoint >= 0xD800 && codepoint < 0xDC00 && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] < 0xE000)
+			{
+				codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (chars[i + 1] - 0xDC00);
+				i++;
+			}
+
+			if (codepoint < 0x80)
+			{
+				result.push_back((char)codepoint);
+			}
+			else if (codepoint < 0x800)
+			{
+				result.push_back((char)(0xC0 | (codepoint >> 6)));
+				result.push_back((char)(0x80 | (codepoint & 0x3F)));
+			}
+			else if (codepoint < 0x10000)
+			{
+				result.push_back((char)(0xE0 | (codepoint >> 12)));
+				result.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+				result.push_back((char)(0x80 | (codepoint & 0x3F)));
+			}
+			else
+			{
+				result.push_back((char)(0xF0 | (codepoint >> 18)));
+				result.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+				result.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+				result.push_back((char)(0x80 | (codepoint & 0x3F)));
+			}
+		}
+
+		return result;
+	}
+
 	Ref<ScriptInstance> ScriptEngine::GetScriptInstance(Entity entity)
 	{
 		Z_CORE_ASSERT(entity.HasComponents<ScriptComponent>());
@@ -2,6 +2,8 @@
 
 #include "Zahra/Assets/Asset.h"
 #include "Zahra/Core/Buffer.h"
+#include "Zahra/Core/FrameAllocator.h"
+#include "Zahra/Core/PoolAllocator.h"
 #include "Zahra/Scene/Entity.h"
 #include "Zahra/Scripting/MonoExterns.h"
 
@@ -134,6 +136,9 @@ namespace Zahra
 	class ScriptInstance : public Asset
 	{
 	public:
+		// one of these is created per scripted entity every time we enter play mode
+		Z_POOL_ALLOCATED()
+
 		ScriptInstance(Ref<ScriptClass> scriptClass, UUID entityID);
 
 		Ref<ScriptClass> GetScriptClass() { return m_ScriptClass; }
@@ -209,6 +214,9 @@ namespace Zahra
 
 		static MonoString* StdStringToMonoString(const std::string& string);
 
+		// converts to UTF-8 in the frame allocator, so the result is only valid for the current frame
+		static FrameString MonoStringToFrameString(MonoString* string);
+
 	private:
 		static void CreateRootDomain();
 		static void CreateAppDomain();
@@ -53,49 +53,46 @@ namespace Zahra
 		// LOGGING
 		static void Log_Trace(MonoString* log)
 		{
-			char* logChars = mono_string_to_utf8(log);
-			Z_SCRIPT_TRACE(logChars);
-			mono_free(logChars); // NOTE: manually free things mono has allocated for us!
+			FrameString logString = ScriptEngine::MonoStringToFrameString(log);
+			Z_SCRIPT_TRACE(logString.c_str());
 		}
 
 		static void Log_Info(MonoString* log)
 		{
-			char* logChars = mono_string_to_utf8(log);
-			Z_SCRIPT_INFO(logChars);
-			mono_free(logChars);
+			FrameString logString = ScriptEngine::MonoStringToFrameString(log);
+			Z_SCRIPT_INFO(logString.c_str());
 		}
 
 		static void Log_Warn(MonoString* log)
 		{
-			char* logChars = mono_string_to_utf8(log);
-			Z_SCRIPT_WARN(logChars);
-			mono_free(logChars);
+			FrameString logString = ScriptEngine::MonoStringToFrameString(log);
+			Z_SCRIPT_WARN(logString.c_str());
 		}
 
 		static void Log_Error(MonoString* log)
 		{
-			char* logChars = mono_string_to_utf8(log);
-			Z_SCRIPT_ERROR(logChars);
-			mono_free(logChars);
+			FrameString logString = ScriptEngine::MonoStringToFrameString(log);
+			Z_SCRIPT_ERROR(logString.c_str());
 		}
 
 		static void Log_Critical(MonoString* log)
 		{
-			char* logChars = mono_string_to_utf8(log);
-			Z_SCRIPT_CRITICAL(logChars);
-			mono_free(logChars);
+			FrameString logString = ScriptEngine::MonoStringToFrameString(log);
+			Z_SCRIPT_CRITICAL(logString.c_str());
 		}
 
 		///////////////////////////////////////////////////////////////////////////////////////////////////
 		// WINDOW
 		static float Window_GetWidth()
 		{
-			return (float)Application::Get().GetWindow().GetWidth();
+			Application& app = Application::Get();
+			return app.IsHeadless() ? .0f : (float)app.GetWindow().GetWidth();
 		}
 
 		static float Window_GetHeight()
 		{
-			return (float)Application::Get().GetWindow().GetHeight();
+			Application& app = Application::Get();
+			return app.IsHeadless() ? .0f : (float)app.GetWindow().GetHeight();
 		}
 
 		#pragma endregion
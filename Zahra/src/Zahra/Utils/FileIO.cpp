@@ -32,6 +32,14 @@ namespace Zahra
 		return buffer;
 	}
 
+	SharedBuffer FileIO::ReadBuffer(const std::filesystem::path& filepath)
+	{
+		uint32_t size = 0;
+		char* data = ReadBytes(filepath, &size);
+
+		return SharedBuffer::Adopt(data, size);
+	}
+
 	std::string FileIO::ReadAsString(const std::filesystem::path& filepath)
 	{
 		std::string result;
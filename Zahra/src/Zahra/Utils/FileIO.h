@@ -1,11 +1,14 @@
 #pragma once
 
+#include "Zahra/Core/Buffer.h"
+
 namespace Zahra
 {
 	class FileIO
 	{
 	public:
 		static char* ReadBytes(const std::filesystem::path& filepath, uint32_t* outSize = nullptr);
+		static SharedBuffer ReadBuffer(const std::filesystem::path& filepath);
 
 		static std::string ReadAsString(const std::filesystem::path& filepath);
 
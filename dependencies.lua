@@ -44,4 +44,5 @@ Library["SPIRV_Cross_GLSL_Release"] = "%{LibraryDir.VulkanSDK}/spirv-cross-glsl.
 Library["WinSock"] = "Ws2_32.lib"
 Library["WinMultimedia"] = "Winmm.lib"
 Library["WinVersion"] = "Version.lib"
-Library["WinBCrypt"] = "Bcrypt.lib"
\ No newline at end of file
+Library["WinBCrypt"] = "Bcrypt.lib"
+Library["WinDbgHelp"] = "Dbghelp.lib"
\ No newline at end of file
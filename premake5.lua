@@ -37,6 +37,7 @@ group "ZahraCore"
 
 group "Misc."
 	include "Sandbox"
+	include "Benchmarks"
 
 
 